@@ -13,6 +13,16 @@ QMAKE_CXXFLAGS += -Wall -Werror
 QMAKE_CXXFLAGS += -Ijson/ -I$$PWD -I/usr/include/
 DEFINES += API_LIBRARY
 LIBS += -lstdc++fs -lz
+# brotli and zstd are optional, each is built in when pkg-config finds it
+CONFIG += link_pkgconfig
+packagesExist(libbrotlienc) {
+    DEFINES += VIKING_BROTLI
+    PKGCONFIG += libbrotlienc
+}
+packagesExist(libzstd) {
+    DEFINES += VIKING_ZSTD
+    PKGCONFIG += libzstd
+}
 
 
 QMAKE_CXXFLAGS_DEBUG += -O0 -g
@@ -38,10 +48,20 @@ SOURCES += \
     io/schedulers/channel.cpp \
     http/resolution.cpp \
     cache/resource_cache.cpp \
+    cache/precompressed.cpp \
+    cache/watcher.cpp \
+    cache/path_cache.cpp \
+    cache/warmup.cpp \
+    cache/bundle.cpp \
     http/directory_listing.cpp
 
 HEADERS += \
     cache/file_descriptor.h \
+    cache/precompressed.h \
+    cache/watcher.h \
+    cache/path_cache.h \
+    cache/warmup.h \
+    cache/bundle.h \
 #CACHE-END
     http/util.h \
     misc/string_util.h \
@@ -55,15 +75,26 @@ HEADERS += \
 SOURCES += \
     http/request.cpp \
     http/response.cpp \
+    http/header_map.cpp \
+    http/compression_policy.cpp \
+    http/delivery_policy.cpp \
+    http/content_sniffer.cpp \
+    http/content_negotiation.cpp \
     http/routeutility.cpp \
     http/engine.cpp \
     http/parser.c \
     io/buffers/unix_file.cpp \
     io/schedulers/sched_item.cpp \
-    io/buffers/utils.cpp
+    io/buffers/buffer_pool.cpp \
+    io/buffers/sealed_memfd.cpp
 
 HEADERS += \
     http/header.h \
+    http/header_map.h \
+    http/compression_policy.h \
+    http/delivery_policy.h \
+    http/content_sniffer.h \
+    http/content_negotiation.h \
     http/parser.h \
     http/engine.h \
     http/request.h \
@@ -73,8 +104,7 @@ HEADERS += \
     http/response_serializer.h \
     io/buffers/datasource.h \
     io/buffers/unix_file.h \
-    io/schedulers/sched_item.h \
-    io/buffers/utils.h
+    io/schedulers/sched_item.h
 
 #IO
 SOURCES += \
@@ -88,7 +118,10 @@ HEADERS += \
     io/socket/socket.h \
     io/schedulers/sys_epoll.h \
     io/schedulers/io_scheduler.h \
-    io/buffers/mem_buffer.h
+    io/buffers/mem_buffer.h \
+    io/buffers/shared_buffer.h \
+    io/buffers/buffer_pool.h \
+    io/buffers/sealed_memfd.h
 
 #IO-END
 
@@ -105,6 +138,8 @@ SOURCES += \
     misc/resource.cpp \
     misc/settings.cpp \
     misc/storage.cpp \
+    misc/compression.cpp \
+    misc/thread_pool.cpp \
 
 HEADERS += \
     misc/date.h \
@@ -112,6 +147,7 @@ HEADERS += \
     misc/settings.h \
     misc/storage.h \
     misc/debug.h \
+    misc/thread_pool.h \
 #MISC-END
 
 #UTIL
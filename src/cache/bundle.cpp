@@ -0,0 +1,226 @@
+/*
+Copyright (C) 2015 Voinea Constantin Vladimir
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+#include <cache/bundle.h>
+#include <cache/path_cache.h>
+#include <http/content_negotiation.h>
+#include <misc/debug.h>
+#include <misc/storage.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace cache;
+
+/* The layout written by tools/bundle/pack.py, little endian. Strings are offsets into the string table */
+namespace {
+constexpr char bundle_magic[8] = {'v', 'k', 'b', 'u', 'n', 'd', 'l', 'e'};
+constexpr std::uint32_t bundle_version = 1;
+
+struct header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t count;
+    std::uint64_t strings;
+    std::uint64_t strings_size;
+};
+
+/* Variants are stored in order of preference, a length of 0 means the bundle doesn't have it */
+enum variant : std::size_t { identity, br, gzip, variant_count };
+
+struct record {
+    std::uint64_t hash;
+    std::uint64_t offset[variant_count];
+    std::uint64_t length[variant_count];
+    std::int64_t last_write;
+    std::uint32_t path, path_length;
+    std::uint32_t mime_type, mime_type_length;
+    std::uint32_t etag, etag_length;
+};
+
+static_assert(sizeof(header) == 32, "bundle header layout");
+static_assert(sizeof(record) == 88, "bundle record layout");
+
+constexpr const char *encodings[variant_count] = {nullptr, "br", "gzip"};
+constexpr const char *etag_suffixes[variant_count] = {"", "-br", "-gzip"};
+constexpr http::content_negotiation::coding codings[variant_count] = {
+    http::content_negotiation::coding::identity, http::content_negotiation::coding::br,
+    http::content_negotiation::coding::gzip};
+}
+
+struct bundle::mapping {
+    fs::path path;
+    int fd = -1;
+    char *base = nullptr;
+    std::size_t size = 0;
+    ino_t inode = 0;
+    std::time_t mtime = 0;
+    const record *records = nullptr;
+    std::size_t count = 0;
+    const char *strings = nullptr;
+
+    ~mapping() {
+        if (base)
+            ::munmap(base, size);
+        if (-1 != fd)
+            ::close(fd);
+    }
+
+    std::string string(std::uint32_t offset, std::uint32_t length) const { return {strings + offset, length}; }
+};
+
+typedef std::chrono::steady_clock clock_type;
+static std::shared_ptr<const bundle::mapping> current;
+static clock_type::time_point checked;
+
+/* FNV-1a, which pack.py implements as well */
+static std::uint64_t hash(const std::string &path) noexcept {
+    std::uint64_t result = 14695981039346656037ull;
+    for (unsigned char c : path) {
+        result ^= c;
+        result *= 1099511628211ull;
+    }
+    return result;
+}
+
+static bool valid(const bundle::mapping &m) noexcept {
+    if (m.size < sizeof(header))
+        return false;
+    const auto *head = reinterpret_cast<const header *>(m.base);
+    if (std::memcmp(head->magic, bundle_magic, sizeof(bundle_magic)) || head->version != bundle_version)
+        return false;
+    if (sizeof(header) + head->count * sizeof(record) > m.size || head->strings > m.size ||
+        head->strings_size > m.size - head->strings)
+        return false;
+    const auto *records = reinterpret_cast<const record *>(m.base + sizeof(header));
+    for (std::size_t i = 0; i < head->count; ++i) {
+        const auto &r = records[i];
+        if (i && records[i - 1].hash > r.hash)
+            return false;
+        for (auto string : {std::make_pair(r.path, r.path_length), std::make_pair(r.mime_type, r.mime_type_length),
+                            std::make_pair(r.etag, r.etag_length)})
+            if (static_cast<std::uint64_t>(string.first) + string.second > head->strings_size)
+                return false;
+        for (std::size_t v = identity; v < variant_count; ++v)
+            if (r.offset[v] > m.size || r.length[v] > m.size - r.offset[v])
+                return false;
+    }
+    return true;
+}
+
+static std::shared_ptr<const bundle::mapping> map(const fs::path &path) noexcept {
+    auto m = std::make_shared<bundle::mapping>();
+    m->path = path;
+    m->fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    struct stat64 st;
+    if (-1 == m->fd || -1 == ::fstat64(m->fd, &st) || st.st_size == 0)
+        return nullptr;
+    m->size = static_cast<std::size_t>(st.st_size);
+    m->inode = st.st_ino;
+    m->mtime = st.st_mtime;
+    void *base = ::mmap(nullptr, m->size, PROT_READ, MAP_SHARED, m->fd, 0);
+    if (base == MAP_FAILED)
+        return nullptr;
+    m->base = static_cast<char *>(base);
+    if (!valid(*m))
+        return nullptr;
+    const auto *head = reinterpret_cast<const header *>(m->base);
+    m->records = reinterpret_cast<const record *>(m->base + sizeof(header));
+    m->count = head->count;
+    m->strings = m->base + head->strings;
+    /* The index is looked at on every request */
+    ::madvise(m->base, sizeof(header) + m->count * sizeof(record), MADV_WILLNEED);
+    return m;
+}
+
+bool bundle::open(const fs::path &path) noexcept {
+    auto m = map(path);
+    if (!m) {
+        debug("Could not open the bundle " + path.string());
+        return false;
+    }
+    current = std::move(m);
+    checked = clock_type::now();
+    return true;
+}
+
+void bundle::close() noexcept { current = nullptr; }
+
+std::size_t bundle::size() noexcept { return current ? current->count : 0; }
+
+/* A new bundle is renamed over the old one, which only shows as a different inode (or a touched file) */
+static void follow_deploys() noexcept {
+    auto now = clock_type::now();
+    if (now - checked < std::chrono::milliseconds(storage::config().cache_staleness_ms))
+        return;
+    checked = now;
+    struct stat64 st;
+    if (-1 == ::stat64(current->path.c_str(), &st) || (st.st_ino == current->inode && st.st_mtime == current->mtime))
+        return;
+    if (auto m = map(current->path))
+        current = std::move(m);
+}
+
+bundle::entry bundle::find(const http::request &request) noexcept {
+    if (!current)
+        return {};
+    follow_deploys();
+    std::string path;
+    if (!path_cache::normalize(request.url, path))
+        return {};
+    const auto key = hash(path);
+    const auto *end = current->records + current->count;
+    auto it = std::lower_bound(current->records, end, key,
+                               [](const record &r, std::uint64_t key) { return r.hash < key; });
+    for (; it != end && it->hash == key; ++it) {
+        if (it->path_length != path.size() || std::memcmp(current->strings + it->path, path.data(), path.size()))
+            continue;
+        std::size_t chosen = identity;
+        bool varies = false;
+        if (storage::config().enable_compression) {
+            http::content_negotiation::coding offered[variant_count];
+            std::size_t count = 0;
+            for (std::size_t v = br; v < variant_count; ++v)
+                if (it->length[v])
+                    offered[count++] = codings[v];
+            const auto coding = http::content_negotiation::choose(request, offered, count);
+            varies = count != 0;
+            for (std::size_t v = br; v < variant_count; ++v)
+                if (codings[v] == coding)
+                    chosen = v;
+        }
+        entry result;
+        result.owner = current;
+        result.fd = current->fd;
+        result.offset = static_cast<off64_t>(it->offset[chosen]);
+        result.length = it->length[chosen];
+        result.data = current->base + it->offset[chosen];
+        result.encoding = encodings[chosen];
+        result.varies = varies;
+        result.mime_type = current->string(it->mime_type, it->mime_type_length);
+        result.etag = '"' + current->string(it->etag, it->etag_length) + etag_suffixes[chosen] + '"';
+        result.last_write = static_cast<std::time_t>(it->last_write);
+        return result;
+    }
+    return {};
+}
@@ -0,0 +1,68 @@
+/*
+Copyright (C) 2015 Voinea Constantin Vladimir
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+#ifndef BUNDLE_H
+#define BUNDLE_H
+
+#include <http/request.h>
+#include <io/filesystem.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <string>
+
+namespace cache {
+/* A directory tree packed into one file by tools/bundle/pack.py: a sorted index of path hashes followed by the
+ * bodies, each with its content type, ETag and precompressed variants. The bundle is mapped once and files are
+ * served from it without a single open() or stat(). Deploying a new bundle is a rename() over the old one, it is
+ * picked up within configuration::cache_staleness_ms while transfers from the old one finish undisturbed.
+ */
+class bundle {
+    public:
+    struct mapping;
+
+    /* One variant of a packed file */
+    struct entry {
+        /* Keeps the mapping, and with it fd and data, alive for as long as the entry is */
+        std::shared_ptr<const mapping> owner;
+        int fd = -1;
+        const char *data = nullptr;
+        off64_t offset = 0;
+        std::size_t length = 0;
+        /* Content-Encoding of the variant, null for the file as it is */
+        const char *encoding = nullptr;
+        /* Whether the bundle has encoded variants of the file, whichever one was chosen */
+        bool varies = false;
+        std::string mime_type;
+        std::string etag;
+        std::time_t last_write = 0;
+        explicit operator bool() const noexcept { return data != nullptr; }
+    };
+
+    /* Maps the bundle, replacing the one in use. False when it can't be read or isn't a valid bundle */
+    static bool open(const fs::path &) noexcept;
+    static void close() noexcept;
+    /* The variant of the requested file the client accepts best, empty when the bundle doesn't have the file */
+    static entry find(const http::request &) noexcept;
+    static std::size_t size() noexcept;
+};
+}
+
+#endif // BUNDLE_H
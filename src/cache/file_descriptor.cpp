@@ -16,49 +16,148 @@ License along with this library; if not, write to the Free Software
 Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 
 */
-#include <algorithm>
 #include <cache/file_descriptor.h>
+#include <cache/watcher.h>
+#include <chrono>
 #include <fcntl.h>
+#include <list>
 #include <misc/common.h>
+#include <misc/storage.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
 #include <unordered_map>
 #include <utility>
 
+using namespace cache;
+
+typedef std::chrono::steady_clock clock_type;
+
 struct handle_use_count {
-    std::size_t use_count;
+    fs::path path;
     int handle;
-    bool operator==(const handle_use_count &other) {
-        return (handle == other.handle) && (use_count == other.use_count);
-    }
+    std::size_t use_count;
+    file_descriptor::metadata meta;
+    clock_type::time_point checked;
 };
 
-static std::unordered_map<fs::path, handle_use_count> storage;
+/* Entries move between the two lists with splice, which keeps the iterators in the indexes valid.
+ * The front of idle is the most recently released descriptor, eviction closes from the back.
+ */
+typedef std::list<handle_use_count> entry_list;
+static entry_list active;
+static entry_list idle;
+static std::unordered_map<fs::path, entry_list::iterator> by_path;
+static std::unordered_map<int, entry_list::iterator> by_handle;
+/* Descriptors of files that changed while still being sent. They are closed by the last release() */
+static std::unordered_map<int, std::size_t> retired;
+
+static void forget(entry_list::iterator it) noexcept {
+    by_path.erase(it->path);
+    by_handle.erase(it->handle);
+}
+
+static void close_idle(entry_list::iterator it) noexcept {
+    ::close(it->handle);
+    forget(it);
+    idle.erase(it);
+}
 
-int cache::file_descriptor::aquire(const std::string &path) noexcept {
-    auto it = storage.find(path);
-    if (it != storage.end()) {
-        ++(it->second.use_count);
-        return it->second.handle;
+static void retire(entry_list::iterator it) noexcept {
+    if (it->use_count == 0) {
+        close_idle(it);
     } else {
-        int fd = ::open(path.c_str(), O_RDONLY);
-        if (fd != -1) {
-            storage.emplace(std::make_pair(path, handle_use_count{1, fd}));
-            return fd;
+        retired[it->handle] += it->use_count;
+        forget(it);
+        active.erase(it);
+    }
+}
+
+static void evict() noexcept {
+    const auto limit = storage::config().fd_cache_size;
+    while (idle.size() > limit)
+        close_idle(std::prev(idle.end()));
+}
+
+/* With a watcher running, invalidate() keeps the entries current. Otherwise they are checked against the
+ * disk once configuration::cache_staleness_ms has passed, like the resource cache does.
+ */
+static bool still_valid(handle_use_count &entry) noexcept {
+    if (likely(watcher::active()))
+        return true;
+    auto now = clock_type::now();
+    if (now - entry.checked < std::chrono::milliseconds(storage::config().cache_staleness_ms))
+        return true;
+    struct stat64 current;
+    if (-1 == ::stat64(entry.path.c_str(), &current) || current.st_ino != entry.meta.inode ||
+        current.st_size != entry.meta.size || current.st_mtime != entry.meta.mtime)
+        return false;
+    entry.checked = now;
+    return true;
+}
+
+int file_descriptor::aquire(const std::string &path) noexcept {
+    auto it = by_path.find(path);
+    if (it != by_path.end()) {
+        auto entry = it->second;
+        if (still_valid(*entry)) {
+            if (entry->use_count++ == 0)
+                active.splice(active.begin(), idle, entry);
+            return entry->handle;
         }
+        retire(entry);
+    }
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+        return -1;
+    struct stat64 stat;
+    if (-1 == ::fstat64(fd, &stat)) {
+        ::close(fd);
+        return -1;
     }
-    return -1;
+    active.push_front({path, fd, 1, {stat.st_size, stat.st_mtime, stat.st_ino}, clock_type::now()});
+    by_path.emplace(path, active.begin());
+    by_handle.emplace(fd, active.begin());
+    return fd;
 }
 
-void cache::file_descriptor::release(int file_descriptor) noexcept {
-    auto it = std::find_if(storage.begin(), storage.end(),
-                           [file_descriptor](auto &pair) { return file_descriptor == pair.second.handle; });
-    if (it != storage.end()) {
-        --(it->second.use_count);
-        if (it->second.use_count == 0) {
-            ::close(it->second.handle);
-            storage.erase(it->first);
+void file_descriptor::release(int file_descriptor) noexcept {
+    auto it = by_handle.find(file_descriptor);
+    if (it != by_handle.end()) {
+        auto entry = it->second;
+        if (--(entry->use_count) == 0) {
+            idle.splice(idle.begin(), active, entry);
+            evict();
         }
+    } else {
+        auto retired_it = retired.find(file_descriptor);
+        if (retired_it != retired.end() && --(retired_it->second) == 0) {
+            ::close(file_descriptor);
+            retired.erase(retired_it);
+        }
+    }
+}
+
+const file_descriptor::metadata *file_descriptor::stat(int file_descriptor) noexcept {
+    auto it = by_handle.find(file_descriptor);
+    return it != by_handle.end() ? &it->second->meta : nullptr;
+}
+
+off64_t file_descriptor::size(int file_descriptor) noexcept {
+    auto meta = stat(file_descriptor);
+    return meta ? meta->size : -1;
+}
+
+void file_descriptor::invalidate(const fs::path &path) noexcept {
+    if (path.empty()) {
+        while (!active.empty())
+            retire(active.begin());
+        while (!idle.empty())
+            retire(idle.begin());
+        return;
     }
+    auto it = by_path.find(path);
+    if (it != by_path.end())
+        retire(it->second);
 }
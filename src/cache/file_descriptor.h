@@ -21,11 +21,30 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include <io/filesystem.h>
 
+#include <sys/types.h>
+#include <time.h>
+
 namespace cache {
+/* Descriptors stay open after their last release, up to configuration::fd_cache_size idle ones, so that
+ * sending a popular file needs neither open() nor stat()
+ */
 class file_descriptor {
     public:
+    /* fstat results, taken once when the file is opened */
+    struct metadata {
+        off64_t size;
+        time_t mtime;
+        ino64_t inode;
+    };
+
     static int aquire(const std::string &) noexcept;
     static void release(int) noexcept;
+    /* Metadata of a descriptor returned by aquire(), null for any other descriptor */
+    static const metadata *stat(int) noexcept;
+    /* Size of a descriptor returned by aquire(), -1 for any other descriptor */
+    static off64_t size(int) noexcept;
+    /* New aquires of a changed file open it again. An empty path invalidates everything */
+    static void invalidate(const fs::path &) noexcept;
 };
 }
 
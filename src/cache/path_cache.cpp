@@ -0,0 +1,152 @@
+/*
+Copyright (C) 2015 Voinea Constantin Vladimir
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+#include <cache/path_cache.h>
+#include <cache/watcher.h>
+#include <http/util.h>
+#include <misc/common.h>
+#include <misc/storage.h>
+
+#include <algorithm>
+#include <chrono>
+#include <list>
+#include <mutex>
+#include <sys/stat.h>
+#include <unordered_map>
+
+using namespace cache;
+
+typedef std::chrono::steady_clock clock_type;
+
+struct cached_entry {
+    path_cache::entry value;
+    clock_type::time_point checked;
+};
+
+typedef std::list<std::pair<std::string, cached_entry>> entry_list;
+/* Most recently used at the front. Route handlers reach the cache from their own threads through
+ * http::util::is_disk_resource, so both are only touched under the lock. Probing happens outside of it
+ */
+static entry_list entries;
+static std::unordered_map<std::string, entry_list::iterator> by_path;
+static std::mutex lock;
+
+static path_cache::entry probe(const fs::path &path) noexcept {
+    path_cache::entry result;
+    result.path = path;
+    struct stat64 stat;
+    if (-1 == ::stat64(path.c_str(), &stat))
+        return result;
+    if (S_ISREG(stat.st_mode))
+        result.type = path_cache::kind::file;
+    else if (S_ISDIR(stat.st_mode))
+        result.type = path_cache::kind::directory;
+    else
+        return result;
+    result.size = static_cast<std::uintmax_t>(stat.st_size);
+    result.last_write = fs::file_time_type::clock::from_time_t(stat.st_mtim.tv_sec) +
+                        std::chrono::duration_cast<fs::file_time_type::duration>(
+                            std::chrono::nanoseconds(stat.st_mtim.tv_nsec));
+    if (result.type == path_cache::kind::file)
+        result.mime_type = http::util::get_mimetype(path);
+    return result;
+}
+
+static bool fresh(const cached_entry &cached, clock_type::time_point now) noexcept {
+    const auto &config = storage::config();
+    if (!cached.value)
+        return now - cached.checked < std::chrono::milliseconds(config.path_cache_negative_ttl_ms);
+    if (likely(watcher::active()))
+        return true;
+    return now - cached.checked < std::chrono::milliseconds(config.cache_staleness_ms);
+}
+
+path_cache::entry path_cache::lookup(const fs::path &path) noexcept {
+    auto now = clock_type::now();
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        auto it = by_path.find(path.native());
+        if (it != by_path.end()) {
+            auto cached = it->second;
+            entries.splice(entries.begin(), entries, cached);
+            if (likely(fresh(cached->second, now)))
+                return cached->second.value;
+        }
+    }
+
+    auto probed = probe(path);
+    auto limit = storage::config().path_cache_size;
+    if (limit == 0)
+        return probed;
+    std::lock_guard<std::mutex> guard(lock);
+    /* Another thread may have probed the same path meanwhile */
+    auto it = by_path.find(path.native());
+    if (it != by_path.end()) {
+        it->second->second = {probed, now};
+        return probed;
+    }
+    while (entries.size() >= limit) {
+        by_path.erase(entries.back().first);
+        entries.pop_back();
+    }
+    entries.emplace_front(path.native(), cached_entry{probed, now});
+    by_path.emplace(path.native(), entries.begin());
+    return probed;
+}
+
+bool path_cache::normalize(const std::string &url, std::string &normalized) noexcept {
+    normalized.clear();
+    const auto size = std::min(url.find('?'), url.size());
+    std::size_t begin = 0;
+    while (begin < size) {
+        auto end = std::min(url.find('/', begin), size);
+        auto length = end - begin;
+        if (length == 2 && url[begin] == '.' && url[begin + 1] == '.') {
+            auto parent = normalized.rfind('/');
+            if (parent == std::string::npos)
+                return false;
+            normalized.resize(parent);
+        } else if (length != 0 && !(length == 1 && url[begin] == '.')) {
+            normalized += '/';
+            normalized.append(url, begin, length);
+        }
+        begin = end + 1;
+    }
+    return true;
+}
+
+path_cache::entry path_cache::resolve(const std::string &url) noexcept {
+    std::string normalized;
+    if (!normalize(url, normalized))
+        return {};
+    return lookup(storage::config().root_path + normalized);
+}
+
+void path_cache::invalidate(const fs::path &path) noexcept {
+    std::lock_guard<std::mutex> guard(lock);
+    if (path.empty()) {
+        by_path.clear();
+        entries.clear();
+        return;
+    }
+    auto it = by_path.find(path.native());
+    if (it != by_path.end()) {
+        entries.erase(it->second);
+        by_path.erase(it);
+    }
+}
@@ -0,0 +1,59 @@
+/*
+Copyright (C) 2015 Voinea Constantin Vladimir
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+#ifndef PATH_CACHE_H
+#define PATH_CACHE_H
+
+#include <io/filesystem.h>
+
+#include <cstdint>
+#include <string>
+
+namespace cache {
+/* What paths under the document root resolve to, so that repeated requests, including the ones for files
+ * that don't exist, cost a hash lookup instead of a round of filesystem probes. Bounded by
+ * configuration::path_cache_size with LRU eviction. Negative entries expire after
+ * configuration::path_cache_negative_ttl_ms, positive ones are kept current by the watcher.
+ */
+class path_cache {
+    public:
+    enum class kind : std::uint8_t { missing, file, directory };
+    struct entry {
+        kind type = kind::missing;
+        fs::path path;
+        std::uintmax_t size = 0;
+        fs::file_time_type last_write;
+        /* Of files, from the extension or, without one, sniffed from the contents */
+        std::string mime_type;
+        explicit operator bool() const noexcept { return type != kind::missing; }
+    };
+
+    /* Resolves a request url below root_path. Urls that would leave it resolve to missing */
+    static entry resolve(const std::string &url) noexcept;
+    /* Same for a path that is already absolute, e.g. a precompressed sibling */
+    static entry lookup(const fs::path &) noexcept;
+    /* Collapses empty and "." segments and applies "..", the query string is left out. False when the url climbs
+     * above the root
+     */
+    static bool normalize(const std::string &url, std::string &normalized) noexcept;
+    /* Drops the entry for the path, or everything when the path is empty */
+    static void invalidate(const fs::path &) noexcept;
+};
+}
+
+#endif // PATH_CACHE_H
@@ -0,0 +1,168 @@
+/*
+Copyright (C) 2015 Voinea Constantin Vladimir
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+#include <cache/precompressed.h>
+#include <http/compression_policy.h>
+#include <http/content_negotiation.h>
+#include <http/util.h>
+#include <misc/compression.h>
+#include <misc/debug.h>
+#include <misc/storage.h>
+
+#include <fstream>
+#include <system_error>
+#include <vector>
+
+using namespace cache;
+typedef http::content_negotiation negotiation;
+
+struct sibling {
+    const char *suffix;
+    const char *encoding;
+    negotiation::coding coding;
+};
+
+/* In order of preference */
+static constexpr sibling siblings[] = {{".br", "br", negotiation::coding::br},
+                                       {".gz", "gzip", negotiation::coding::gzip}};
+constexpr std::size_t sibling_count = sizeof(siblings) / sizeof(siblings[0]);
+
+static bool is_fresh(const fs::path &sibling_path, const fs::path &original) noexcept {
+    std::error_code ec;
+    if (!fs::is_regular_file(sibling_path, ec))
+        return false;
+    auto sibling_time = fs::last_write_time(sibling_path, ec);
+    if (ec)
+        return false;
+    auto original_time = fs::last_write_time(original, ec);
+    return !ec && sibling_time >= original_time;
+}
+
+precompressed::variant precompressed::find(const http::request &request, const path_cache::entry &file) noexcept {
+    if (!storage::config().enable_compression)
+        return {};
+    variant found[sibling_count];
+    negotiation::coding offered[sibling_count];
+    std::size_t count = 0;
+    for (const auto &s : siblings) {
+        auto candidate = path_cache::lookup(file.path.string() + s.suffix);
+        if (candidate.type == path_cache::kind::file && candidate.last_write >= file.last_write) {
+            found[count] = {candidate.path, s.encoding, true};
+            offered[count++] = s.coding;
+        }
+    }
+    /* The client's q-values decide between the siblings there are, ties go to the smaller one */
+    const auto chosen = negotiation::choose(request, offered, count);
+    for (std::size_t i = 0; i < count; ++i)
+        if (offered[i] == chosen)
+            return found[i];
+    variant identity;
+    identity.varies = count != 0;
+    return identity;
+}
+
+/* Compressed a piece at a time, so that a large file is never held in memory as a whole */
+static bool gzip_file(const fs::path &path, std::ostream &target) {
+    constexpr std::size_t piece_size = 64 * 1024;
+    std::ifstream source(path, std::ios::binary);
+    std::vector<char> piece(piece_size);
+    std::vector<char> gzipped;
+    compression::stream compressor{compression::format::gzip, Z_BEST_COMPRESSION};
+    while (source) {
+        source.read(piece.data(), piece.size());
+        compressor.write(piece.data(), static_cast<std::size_t>(source.gcount()), gzipped);
+        target.write(gzipped.data(), gzipped.size());
+        gzipped.clear();
+    }
+    if (source.bad())
+        return false;
+    compressor.finish(gzipped);
+    target.write(gzipped.data(), gzipped.size());
+    return static_cast<bool>(target);
+}
+
+#ifdef VIKING_BROTLI
+/* brotli is only used on text files, those are read whole. Nothing is written for a file that couldn't be read,
+ * an empty one gains nothing from a sibling either
+ */
+static bool brotli_file(const fs::path &path, std::ostream &target) {
+    auto content = io::read_file(path);
+    if (content.empty())
+        return false;
+    auto compressed = compression::brotli(content, 11);
+    target.write(compressed.data(), compressed.size());
+    return static_cast<bool>(target);
+}
+#endif
+
+/* Written to a temporary first, so that a half written sibling is never served */
+static bool write_sibling(const fs::path &path, const fs::path &target,
+                          bool (*compress)(const fs::path &, std::ostream &)) noexcept {
+    if (is_fresh(target, path))
+        return false;
+    std::error_code ec;
+    try {
+        fs::path temporary = target.string() + ".tmp";
+        std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+        if (!compress(path, stream))
+            stream.setstate(std::ios::failbit);
+        stream.close();
+        if (stream)
+            fs::rename(temporary, target, ec);
+        if (!stream || ec) {
+            fs::remove(temporary, ec);
+            return false;
+        }
+        return true;
+    } catch (...) {
+        debug("Could not precompress " + path.string());
+    }
+    return false;
+}
+
+static bool is_sibling(const fs::path &path) noexcept {
+    auto ext = path.extension().string();
+    for (const auto &s : siblings)
+        if (ext == s.suffix)
+            return true;
+    return false;
+}
+
+std::size_t precompressed::generate(const fs::path &root) noexcept {
+    std::size_t generated = 0;
+    /* ec is only for the walk, a file that vanished or can't be read is skipped on its own */
+    std::error_code ec;
+    for (fs::recursive_directory_iterator it(root, fs::directory_options::skip_permission_denied, ec), end;
+         !ec && it != end; it.increment(ec)) {
+        const fs::path &path = it->path();
+        std::error_code entry_ec;
+        if (!fs::is_regular_file(path, entry_ec) || is_sibling(path))
+            continue;
+        if (http::compression_policy::classify(http::util::get_mimetype(path)) !=
+            http::compression_policy::content_class::text)
+            continue;
+        const auto size = fs::file_size(path, entry_ec);
+        if (entry_ec || size < storage::config().compression_min_size)
+            continue;
+        generated += write_sibling(path, path.string() + ".gz", gzip_file);
+#ifdef VIKING_BROTLI
+        generated += write_sibling(path, path.string() + ".br", brotli_file);
+#endif
+    }
+    return generated;
+}
@@ -0,0 +1,51 @@
+/*
+Copyright (C) 2015 Voinea Constantin Vladimir
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+#ifndef PRECOMPRESSED_H
+#define PRECOMPRESSED_H
+
+#include <cache/path_cache.h>
+#include <http/request.h>
+#include <io/filesystem.h>
+
+namespace cache {
+/* Compressed siblings of static files (file.br, file.gz) that can be sent with sendfile instead of
+ * compressing the original on every request.
+ */
+class precompressed {
+    public:
+    struct variant {
+        fs::path path;
+        const char *encoding = nullptr;
+        /* Whether the file has siblings at all, the response then varies with Accept-Encoding even without one */
+        bool varies = false;
+        explicit operator bool() const noexcept { return encoding != nullptr; }
+    };
+
+    /* The sibling of the given file the client rates highest among those not older than the file. Without one the
+     * variant is false, but still tells whether there were siblings to choose from
+     */
+    static variant find(const http::request &, const path_cache::entry &) noexcept;
+    /* Writes file.gz (and file.br, when built with brotli) next to every compressible file under root that lacks an
+     * up to date one
+     */
+    static std::size_t generate(const fs::path &root) noexcept;
+};
+}
+
+#endif // PRECOMPRESSED_H
@@ -17,22 +17,252 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 
 */
 #include <cache/resource_cache.h>
+#include <cache/watcher.h>
 #include <misc/common.h>
+#include <misc/storage.h>
 
-resource cache::resource_cache::aquire(fs::path p) {
-    static std::unordered_map<fs::path, resource> storage;
+#include <chrono>
+#include <list>
+#include <unordered_map>
+#include <vector>
 
-    auto r = storage.find(p);
-    if (!fs::exists(p) && r != storage.end()) {
-        storage.erase(r);
-        return {};
+using namespace cache;
+
+namespace {
+class s3fifo {
+    static constexpr std::uint8_t max_frequency = 3;
+    /* Share of the budget given to the probationary queue */
+    static constexpr std::size_t small_queue_share = 10;
+
+    enum class queue { small, main };
+
+    public:
+    typedef std::chrono::steady_clock clock;
+    struct entry {
+        resource res;
+        std::size_t bytes;
+        std::uint8_t frequency;
+        queue in;
+        /* When the entry was last known to match the disk */
+        clock::time_point checked;
+    };
+
+    private:
+    typedef std::list<entry> fifo;
+    typedef std::list<fs::path> ghost_fifo;
+
+    fifo small, main;
+    std::size_t small_bytes = 0, main_bytes = 0;
+    std::unordered_map<fs::path, fifo::iterator> index;
+    /* Keys recently evicted from the small queue. Seeing one of them again sends it straight to main */
+    ghost_fifo ghost;
+    std::unordered_map<fs::path, ghost_fifo::iterator> ghost_index;
+
+    static std::size_t budget() noexcept { return storage::config().cache_byte_budget; }
+
+    void remember(const fs::path &path) {
+        ghost.push_front(path);
+        ghost_index[path] = ghost.begin();
+        while (ghost.size() > std::max<std::size_t>(index.size(), 1)) {
+            ghost_index.erase(ghost.back());
+            ghost.pop_back();
+        }
+    }
+
+    void forget_ghost(const fs::path &path) noexcept {
+        auto it = ghost_index.find(path);
+        if (it != ghost_index.end()) {
+            ghost.erase(it->second);
+            ghost_index.erase(it);
+        }
+    }
+
+    void evict_small() {
+        auto &victim = small.back();
+        small_bytes -= victim.bytes;
+        if (victim.frequency > 0) {
+            victim.frequency = 0;
+            victim.in = queue::main;
+            main_bytes += victim.bytes;
+            main.splice(main.begin(), small, std::prev(small.end()));
+        } else {
+            auto path = victim.res.path();
+            index.erase(path);
+            small.pop_back();
+            remember(path);
+            ++stats.evictions;
+        }
+    }
+
+    void evict_main() {
+        auto &victim = main.back();
+        if (victim.frequency > 0) {
+            --victim.frequency;
+            main.splice(main.begin(), main, std::prev(main.end()));
+        } else {
+            main_bytes -= victim.bytes;
+            index.erase(victim.res.path());
+            main.pop_back();
+            ++stats.evictions;
+        }
+    }
+
+    void make_room(std::size_t bytes) {
+        const auto limit = budget();
+        while (small_bytes + main_bytes + bytes > limit && (small.size() || main.size())) {
+            if (small.size() && (small_bytes > limit * small_queue_share / 100 || main.empty()))
+                evict_small();
+            else
+                evict_main();
+        }
+    }
+
+    void account(fifo::iterator it, std::size_t bytes) noexcept {
+        (it->in == queue::small ? small_bytes : main_bytes) += bytes;
+    }
+
+    void unaccount(fifo::iterator it) noexcept { (it->in == queue::small ? small_bytes : main_bytes) -= it->bytes; }
+
+    public:
+    resource_cache::statistics stats;
+
+    entry *find(const fs::path &path) noexcept {
+        auto it = index.find(path);
+        if (it == index.end())
+            return nullptr;
+        auto &e = *it->second;
+        if (e.frequency < max_frequency)
+            ++e.frequency;
+        return &e;
+    }
+
+    /* Hot entries skip the probationary queue */
+    const resource &insert(const resource &res, bool hot = false) {
+        erase(res.path());
+        const auto bytes = res.footprint();
+        if (bytes > budget())
+            return res;
+        make_room(bytes);
+
+        bool seen_recently = hot || ghost_index.count(res.path());
+        forget_ghost(res.path());
+        auto &target = seen_recently ? main : small;
+        target.push_front(entry{res, bytes, 0, seen_recently ? queue::main : queue::small, clock::now()});
+        account(target.begin(), bytes);
+        index[res.path()] = target.begin();
+        return target.front().res;
     }
-    if (r != storage.end()) {
-        if (unlikely(fs::last_write_time(p) > r->second.last_write()))
-            return storage[p] = resource{p};
-        else
-            return r->second;
-    } else {
-        return storage[p] = resource{p};
+
+    void update(const resource &res) {
+        auto it = index.find(res.path());
+        if (it == index.end() || it->second->res.last_write() != res.last_write())
+            return;
+        const auto bytes = res.footprint();
+        /* Like in insert, what can't fit isn't kept at all */
+        if (bytes > budget()) {
+            erase(res.path());
+            return;
+        }
+        auto entry = it->second;
+        unaccount(entry);
+        entry->bytes = 0;
+        make_room(bytes);
+        /* Making room may have evicted the entry itself */
+        if (index.find(res.path()) == index.end())
+            return;
+        entry->res = res;
+        entry->bytes = bytes;
+        account(entry, bytes);
+    }
+
+    void erase(const fs::path &path) noexcept {
+        auto it = index.find(path);
+        if (it == index.end())
+            return;
+        unaccount(it->second);
+        (it->second->in == queue::small ? small : main).erase(it->second);
+        index.erase(it);
+    }
+
+    void clear() noexcept {
+        small.clear();
+        main.clear();
+        index.clear();
+        small_bytes = main_bytes = 0;
+    }
+
+    std::vector<resource> resources() const {
+        std::vector<resource> result;
+        result.reserve(index.size());
+        for (const auto *queue : {&main, &small})
+            for (const auto &e : *queue)
+                result.push_back(e.res);
+        return result;
     }
+
+    std::size_t bytes() const noexcept { return small_bytes + main_bytes; }
+    std::size_t size() const noexcept { return index.size(); }
+};
+
+s3fifo &instance() {
+    static s3fifo cache;
+    return cache;
+}
+}
+
+/* With a watcher running, entries are dropped as soon as their file changes, so they never need checking.
+ * Otherwise they are trusted for configuration::cache_staleness_ms after they were last checked.
+ */
+static inline bool trusted(const s3fifo::entry &e) noexcept {
+    if (likely(watcher::active()))
+        return true;
+    auto staleness = std::chrono::milliseconds(storage::config().cache_staleness_ms);
+    return s3fifo::clock::now() - e.checked < staleness;
+}
+
+resource resource_cache::find(const fs::path &p) {
+    auto &cache = instance();
+    if (auto e = cache.find(p)) {
+        if (trusted(*e)) {
+            ++cache.stats.hits;
+            return e->res;
+        }
+        if (!fs::exists(p)) {
+            cache.erase(p);
+            return {};
+        }
+        if (likely(fs::last_write_time(p) <= e->res.last_write())) {
+            e->checked = s3fifo::clock::now();
+            ++cache.stats.hits;
+            return e->res;
+        }
+    }
+    ++cache.stats.misses;
+    return {};
+}
+
+resource resource_cache::store(const resource &r) { return instance().insert(r); }
+
+resource resource_cache::aquire(fs::path p) {
+    if (auto cached = find(p))
+        return cached;
+    if (!fs::exists(p))
+        return {};
+    return store(resource{p});
+}
+
+void resource_cache::update(const resource &r) { instance().update(r); }
+
+void resource_cache::preload(const resource &r) { instance().insert(r, true); }
+
+std::vector<resource> resource_cache::resources() { return instance().resources(); }
+
+void resource_cache::invalidate(const fs::path &p) noexcept { p.empty() ? instance().clear() : instance().erase(p); }
+
+resource_cache::statistics resource_cache::stats() noexcept {
+    auto &cache = instance();
+    auto result = cache.stats;
+    result.bytes = cache.bytes();
+    result.entries = cache.size();
+    return result;
 }
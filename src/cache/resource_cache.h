@@ -21,10 +21,38 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include <misc/resource.h>
 
+#include <vector>
+
 namespace cache {
+/* In-memory copies of small static files, bounded by configuration::cache_byte_budget. Every encoded
+ * variant counts against the budget. Eviction follows S3-FIFO: new entries go through a small probationary
+ * queue, and only the ones that get hit again while there make it into the main queue, so a scan over
+ * many cold files can't flush the hot set.
+ */
 class resource_cache {
     public:
+    struct statistics {
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+        std::uint64_t evictions = 0;
+        std::size_t bytes = 0;
+        std::size_t entries = 0;
+    };
+
     static resource aquire(fs::path p);
+    /* The cached resource if there is a current one, without going to the disk on a miss */
+    static resource find(const fs::path &);
+    /* Caches a resource that was loaded elsewhere, e.g. on a loader thread */
+    static resource store(const resource &);
+    /* Stores the variants a response computed for a cached resource */
+    static void update(const resource &);
+    /* Stores a resource prepared ahead of time, e.g. at warm-up. It is expected to be hot and skips probation */
+    static void preload(const resource &);
+    /* Everything cached right now, the main queue first */
+    static std::vector<resource> resources();
+    /* Drops the entry for the path, or everything when the path is empty */
+    static void invalidate(const fs::path &) noexcept;
+    static statistics stats() noexcept;
 };
 }
 
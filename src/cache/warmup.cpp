@@ -0,0 +1,254 @@
+/*
+Copyright (C) 2015 Voinea Constantin Vladimir
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+#include <cache/path_cache.h>
+#include <cache/resource_cache.h>
+#include <cache/warmup.h>
+#include <http/compression_policy.h>
+#include <http/util.h>
+#include <misc/compression.h>
+#include <misc/debug.h>
+#include <misc/storage.h>
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <fstream>
+#include <system_error>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+using namespace cache;
+
+static constexpr char snapshot_magic[] = "viking cache snapshot 2\n";
+static constexpr std::size_t snapshot_magic_size = sizeof(snapshot_magic) - 1;
+
+namespace {
+struct job {
+    fs::path path;
+    std::string mime_type;
+    /* Snapshot entries bring their variants along with the state of the file they were made from */
+    bool from_snapshot = false;
+    std::int64_t last_write = 0;
+    std::uint64_t size = 0;
+    /* What the variants were compressed with, -1 for none */
+    int level = -1;
+    resource::buffer deflated;
+    resource::buffer gzipped;
+    resource result;
+};
+}
+
+/* The zlib level compressed variants of the file get under the current settings, -1 when it isn't compressed */
+static int variant_level(const fs::path &path, const resource::view &raw) {
+    if (!storage::config().enable_compression)
+        return -1;
+    auto policy = http::compression_policy::decide(http::util::get_mimetype(path), raw.data, raw.size);
+    return policy.compress ? policy.level : -1;
+}
+
+/* Runs on the worker threads, so it must not touch the caches */
+static void prepare(job &j) {
+    j.result = resource{j.path};
+    if (j.from_snapshot) {
+        /* Variants made for other compression settings would be served as they are for as long as they're cached */
+        if (j.result.last_write().time_since_epoch().count() != j.last_write || j.result.raw->size() != j.size ||
+            variant_level(j.path, j.result.raw_bytes()) != j.level) {
+            j.result = {};
+            return;
+        }
+        j.result.deflated = std::move(j.deflated);
+        j.result.gzipped = std::move(j.gzipped);
+        return;
+    }
+    if (!storage::config().enable_compression)
+        return;
+    auto policy = http::compression_policy::decide(j.mime_type, *j.result.raw);
+    if (!policy.compress)
+        return;
+    const auto &raw = *j.result.raw;
+    j.result.deflated = std::make_shared<const std::vector<char>>(compression::deflate(raw, policy.level));
+    j.result.gzipped = std::make_shared<const std::vector<char>>(compression::gzip(raw, policy.level));
+}
+
+static std::size_t run(std::vector<job> &jobs, std::size_t threads) {
+    std::atomic<std::size_t> next{0};
+    auto work = [&jobs, &next]() {
+        for (std::size_t i; (i = next++) < jobs.size();) {
+            try {
+                prepare(jobs[i]);
+            } catch (...) {
+                jobs[i].result = {};
+            }
+        }
+    };
+    std::vector<std::thread> workers;
+    for (std::size_t t = 1; t < std::min(threads, jobs.size()); ++t)
+        workers.emplace_back(work);
+    work();
+    for (auto &worker : workers)
+        worker.join();
+
+    std::size_t loaded = 0;
+    for (auto &j : jobs) {
+        if (j.result) {
+            resource_cache::preload(j.result);
+            ++loaded;
+        }
+    }
+    return loaded;
+}
+
+static inline std::string trim(const std::string &str) {
+    auto begin = str.find_first_not_of(" \t\r");
+    if (begin == std::string::npos)
+        return {};
+    return str.substr(begin, str.find_last_not_of(" \t\r") - begin + 1);
+}
+
+std::size_t warmup::preload(const fs::path &manifest, std::size_t threads) noexcept {
+    try {
+        std::ifstream stream(manifest);
+        if (!stream) {
+            debug("Could not open the warm-up manifest " + manifest.string());
+            return 0;
+        }
+        std::unordered_set<std::string> cached;
+        for (const auto &res : resource_cache::resources())
+            cached.insert(res.path().native());
+
+        std::vector<job> jobs;
+        for (std::string line; std::getline(stream, line);) {
+            auto url = trim(line.substr(0, line.find('#')));
+            if (url.empty())
+                continue;
+            auto file = path_cache::resolve(url);
+            if (file.type != path_cache::kind::file || !cached.insert(file.path.native()).second)
+                continue;
+            job j;
+            j.path = file.path;
+            j.mime_type = file.mime_type;
+            jobs.push_back(std::move(j));
+        }
+        return run(jobs, threads);
+    } catch (...) {
+        return 0;
+    }
+}
+
+template <typename T> static inline void write_number(std::ofstream &stream, T number) {
+    auto value = static_cast<std::uint64_t>(number);
+    stream.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+static inline void write_buffer(std::ofstream &stream, const resource::view &bytes) {
+    write_number(stream, bytes.size);
+    if (bytes)
+        stream.write(bytes.data, bytes.size);
+}
+
+static inline std::uint64_t read_number(std::ifstream &stream) {
+    std::uint64_t value = 0;
+    stream.read(reinterpret_cast<char *>(&value), sizeof(value));
+    return value;
+}
+
+static inline resource::buffer read_buffer(std::ifstream &stream) {
+    auto size = read_number(stream);
+    /* Nothing bigger than the cache could have been in it, anything else means a broken file */
+    if (size > storage::config().cache_byte_budget)
+        stream.setstate(std::ios::failbit);
+    if (!stream || size == 0)
+        return nullptr;
+    std::vector<char> buffer(size);
+    stream.read(buffer.data(), size);
+    return std::make_shared<const std::vector<char>>(std::move(buffer));
+}
+
+std::size_t warmup::save_snapshot(const fs::path &path) noexcept {
+    try {
+        fs::path temporary = path.string() + ".tmp";
+        std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+        stream.write(snapshot_magic, snapshot_magic_size);
+        std::size_t saved = 0;
+        for (const auto &res : resource_cache::resources()) {
+            if (!res.raw_bytes())
+                continue;
+            const auto &name = res.path().native();
+            write_number(stream, name.size());
+            stream.write(name.data(), name.size());
+            write_number(stream, res.last_write().time_since_epoch().count());
+            write_number(stream, res.raw_bytes().size);
+            write_number(stream, variant_level(res.path(), res.raw_bytes()));
+            write_buffer(stream, res.deflated_bytes());
+            write_buffer(stream, res.gzipped_bytes());
+            ++saved;
+        }
+        stream.close();
+        std::error_code ec;
+        if (stream)
+            fs::rename(temporary, path, ec);
+        if (!stream || ec) {
+            fs::remove(temporary, ec);
+            debug("Could not write the cache snapshot " + path.string());
+            return 0;
+        }
+        return saved;
+    } catch (...) {
+        return 0;
+    }
+}
+
+std::size_t warmup::load_snapshot(const fs::path &path, std::size_t threads) noexcept {
+    try {
+        std::ifstream stream(path, std::ios::binary);
+        char magic[snapshot_magic_size];
+        if (!stream.read(magic, snapshot_magic_size) || !std::equal(magic, magic + snapshot_magic_size, snapshot_magic))
+            return 0;
+
+        const auto &root = storage::config().root_path;
+        std::vector<job> jobs;
+        while (stream.peek() != std::ifstream::traits_type::eof()) {
+            job j;
+            auto length = read_number(stream);
+            if (!stream || length == 0 || length > PATH_MAX)
+                break;
+            std::string name(length, '\0');
+            stream.read(&name.front(), name.size());
+            j.from_snapshot = true;
+            j.last_write = static_cast<std::int64_t>(read_number(stream));
+            j.size = read_number(stream);
+            j.level = static_cast<int>(static_cast<std::int64_t>(read_number(stream)));
+            j.deflated = read_buffer(stream);
+            j.gzipped = read_buffer(stream);
+            if (!stream)
+                break;
+            /* Written for another document root, /srv/www2 starts with /srv/www too */
+            if (name.compare(0, root.size(), root) != 0 ||
+                (!root.empty() && root.back() != '/' && (name.size() == root.size() || name[root.size()] != '/')))
+                continue;
+            j.path = name;
+            jobs.push_back(std::move(j));
+        }
+        return run(jobs, threads);
+    } catch (...) {
+        return 0;
+    }
+}
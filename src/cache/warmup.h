@@ -0,0 +1,45 @@
+/*
+Copyright (C) 2015 Voinea Constantin Vladimir
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+#ifndef WARMUP_H
+#define WARMUP_H
+
+#include <io/filesystem.h>
+
+#include <cstddef>
+
+namespace cache {
+/* Fills the resource cache before the first request, so that a restarted server doesn't have to read and
+ * compress its hot files while under traffic.
+ */
+class warmup {
+    public:
+    /* Loads the urls listed in the manifest, one per line with '#' starting a comment, together with their
+     * compressed variants. Reading and compressing is spread over the given number of threads.
+     */
+    static std::size_t preload(const fs::path &manifest, std::size_t threads) noexcept;
+    /* Writes what the resource cache holds, compressed variants included */
+    static std::size_t save_snapshot(const fs::path &) noexcept;
+    /* Restores the entries of a snapshot whose files didn't change since it was written, and whose compressed
+     * variants were made with the level the current settings give them
+     */
+    static std::size_t load_snapshot(const fs::path &, std::size_t threads) noexcept;
+};
+}
+
+#endif // WARMUP_H
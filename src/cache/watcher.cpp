@@ -0,0 +1,219 @@
+/*
+Copyright (C) 2015 Voinea Constantin Vladimir
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+#include <cache/watcher.h>
+#include <misc/common.h>
+#include <misc/debug.h>
+
+#include <atomic>
+#include <mutex>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+using namespace cache;
+
+static constexpr std::uint32_t watch_mask = IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | IN_CREATE | IN_DELETE |
+                                            IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF;
+
+namespace {
+struct watch_state {
+    int inotify_fd = -1;
+    int stop_fd = -1;
+    std::thread thread;
+    std::unordered_map<int, std::string> directories;
+
+    std::mutex lock;
+    std::vector<fs::path> changed;
+    std::atomic<bool> pending{false};
+    std::atomic<bool> running{false};
+    /* False once a directory couldn't be watched (ENOSPC past max_user_watches, EACCES...) or a symlink turned up.
+     * Changes below it, or behind the link, would go unnoticed, so from then on the caches can't rely on the watcher
+     */
+    std::atomic<bool> covered{true};
+    std::vector<watcher::listener> listeners;
+
+    ~watch_state() { shutdown(); }
+
+    void shutdown() noexcept {
+        running.store(false, std::memory_order_release);
+        if (thread.joinable()) {
+            std::uint64_t one = 1;
+            if (::write(stop_fd, &one, sizeof(one)) == -1)
+                debug("Could not wake the watcher thread");
+            thread.join();
+        }
+        if (inotify_fd != -1)
+            ::close(inotify_fd);
+        if (stop_fd != -1)
+            ::close(stop_fd);
+        inotify_fd = stop_fd = -1;
+        directories.clear();
+        covered.store(true, std::memory_order_release);
+    }
+
+    void add_directory(const std::string &path) noexcept {
+        int wd = ::inotify_add_watch(inotify_fd, path.c_str(), watch_mask | IN_ONLYDIR);
+        if (wd == -1) {
+            debug("Could not watch " + path + ". errno = " + std::to_string(errno));
+            not_covered(path);
+            return;
+        }
+        directories[wd] = path;
+    }
+
+    /* Directory names are built by appending to the root exactly like the dispatcher builds paths
+     * from the url, so that the paths we report match the keys the caches use
+     */
+    void add_tree(const std::string &root) noexcept {
+        add_directory(root);
+        std::error_code ec;
+        for (fs::directory_iterator it(root, ec), end; !ec && it != end; it.increment(ec)) {
+            std::error_code entry_ec;
+            /* Events only come for the link itself, never for what it points to */
+            if (fs::is_symlink(it->symlink_status(entry_ec)) || entry_ec)
+                not_covered(it->path().string());
+            else if (fs::is_directory(it->status(entry_ec)))
+                add_tree(root + "/" + it->path().filename().string());
+        }
+        if (ec)
+            not_covered(root);
+    }
+
+    void not_covered(const std::string &path) noexcept {
+        debug("Changes behind " + path + " can't be watched");
+        covered.store(false, std::memory_order_release);
+    }
+
+    void queue(fs::path path) {
+        std::lock_guard<std::mutex> guard(lock);
+        changed.emplace_back(std::move(path));
+        pending.store(true, std::memory_order_release);
+    }
+
+    void handle(const inotify_event &event) {
+        if (event.mask & IN_Q_OVERFLOW) {
+            queue({});
+            return;
+        }
+        auto it = directories.find(event.wd);
+        if (it == directories.end())
+            return;
+        if (event.mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) {
+            directories.erase(it);
+            queue({});
+            return;
+        }
+        std::string path = it->second + "/" + event.name;
+        std::error_code ec;
+        if ((event.mask & (IN_CREATE | IN_MOVED_TO)) && fs::is_symlink(fs::symlink_status(path, ec)))
+            not_covered(path);
+        if (event.mask & IN_ISDIR) {
+            if (event.mask & (IN_CREATE | IN_MOVED_TO))
+                add_tree(path);
+            /* Whatever was cached below a directory that moved or vanished is stale */
+            queue({});
+            return;
+        }
+        queue(path);
+    }
+
+    void run() noexcept {
+        alignas(inotify_event) char buffer[16 * 1024];
+        pollfd fds[2] = {{inotify_fd, POLLIN, 0}, {stop_fd, POLLIN, 0}};
+        while (running.load(std::memory_order_acquire)) {
+            if (::poll(fds, 2, -1) == -1) {
+                if (errno == EINTR)
+                    continue;
+                break;
+            }
+            if (fds[1].revents)
+                break;
+            auto length = ::read(inotify_fd, buffer, sizeof(buffer));
+            if (length <= 0)
+                continue;
+            for (char *p = buffer; p < buffer + length;) {
+                auto event = reinterpret_cast<const inotify_event *>(p);
+                handle(*event);
+                p += sizeof(inotify_event) + event->len;
+            }
+        }
+        /* From here on the caches go back to checking the disk themselves */
+        running.store(false, std::memory_order_release);
+    }
+};
+
+watch_state &state() {
+    static watch_state instance;
+    return instance;
+}
+}
+
+bool watcher::start(const fs::path &root) noexcept {
+    stop();
+    auto &s = state();
+    s.inotify_fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    s.stop_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (s.inotify_fd == -1 || s.stop_fd == -1) {
+        debug("inotify is unavailable, falling back to polling the filesystem");
+        s.shutdown();
+        return false;
+    }
+    s.add_tree(root.string());
+    if (s.directories.empty() || !s.covered.load(std::memory_order_acquire)) {
+        debug("Could not watch the whole document root, falling back to polling the filesystem");
+        s.shutdown();
+        return false;
+    }
+    s.running.store(true, std::memory_order_release);
+    try {
+        s.thread = std::thread([&s]() { s.run(); });
+    } catch (...) {
+        s.shutdown();
+        return false;
+    }
+    return true;
+}
+
+void watcher::stop() noexcept { state().shutdown(); }
+
+bool watcher::active() noexcept {
+    auto &s = state();
+    return s.running.load(std::memory_order_relaxed) && s.covered.load(std::memory_order_relaxed);
+}
+
+void watcher::subscribe(listener l) noexcept { state().listeners.emplace_back(std::move(l)); }
+
+void watcher::dispatch() noexcept {
+    auto &s = state();
+    if (likely(!s.pending.load(std::memory_order_acquire)))
+        return;
+    std::vector<fs::path> changed;
+    {
+        std::lock_guard<std::mutex> guard(s.lock);
+        changed.swap(s.changed);
+        s.pending.store(false, std::memory_order_relaxed);
+    }
+    for (const auto &path : changed)
+        for (const auto &l : s.listeners)
+            l(path);
+}
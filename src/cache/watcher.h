@@ -0,0 +1,46 @@
+/*
+Copyright (C) 2015 Voinea Constantin Vladimir
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+#ifndef WATCHER_H
+#define WATCHER_H
+
+#include <io/filesystem.h>
+
+#include <functional>
+
+namespace cache {
+/* Watches the document root with inotify from a background thread. Changes are queued and handed
+ * to the listeners on the reactor thread by dispatch(), which costs an atomic load when nothing changed.
+ * While the watcher is active, the caches trust their entries without going to the disk. It only is while every
+ * directory below the root is watched: start() fails when one can't be, and a directory created later that can't
+ * be watched deactivates it.
+ */
+class watcher {
+    public:
+    /* Called with the path that changed. An empty path means anything may have changed */
+    typedef std::function<void(const fs::path &)> listener;
+
+    static bool start(const fs::path &root) noexcept;
+    static void stop() noexcept;
+    static bool active() noexcept;
+    static void subscribe(listener) noexcept;
+    static void dispatch() noexcept;
+};
+}
+
+#endif // WATCHER_H
@@ -0,0 +1,124 @@
+/*
+Copyright (C) 2015 Voinea Constantin Vladimir
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+#include <http/compression_policy.h>
+#include <misc/storage.h>
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+using namespace http;
+
+static inline bool starts_with(const std::string &str, const char *prefix) noexcept {
+    return str.compare(0, std::strlen(prefix), prefix) == 0;
+}
+
+static inline bool ends_with(const std::string &str, const char *suffix) noexcept {
+    auto len = std::strlen(suffix);
+    return str.size() >= len && str.compare(str.size() - len, len, suffix) == 0;
+}
+
+/* Formats that carry their own compression. Deflating them again costs CPU and usually makes them bigger */
+static constexpr const char *compressed_types[] = {"image/jpeg",
+                                                   "image/png",
+                                                   "image/gif",
+                                                   "image/webp",
+                                                   "image/vnd.ms-photo",
+                                                   "application/zip",
+                                                   "application/gzip",
+                                                   "application/x-gzip",
+                                                   "application/x-bzip",
+                                                   "application/x-bzip2",
+                                                   "application/x-xz",
+                                                   "application/x-7z-compressed",
+                                                   "application/x-rar-compressed",
+                                                   "application/java-archive",
+                                                   "application/vnd.android.package-archive",
+                                                   "application/font-woff",
+                                                   "application/x-font-woff",
+                                                   "font/woff",
+                                                   "font/woff2"};
+
+static constexpr const char *text_types[] = {"application/json",         "application/javascript",
+                                             "application/x-javascript", "application/ecmascript",
+                                             "application/xml",          "application/xhtml+xml",
+                                             "image/svg+xml"};
+
+compression_policy::content_class compression_policy::classify(const std::string &mime_type) noexcept {
+    auto mime = mime_type.substr(0, mime_type.find(';'));
+    if (starts_with(mime, "text/") || ends_with(mime, "+xml") || ends_with(mime, "+json"))
+        return content_class::text;
+    for (auto type : text_types)
+        if (mime == type)
+            return content_class::text;
+    if (starts_with(mime, "video/") || (starts_with(mime, "audio/") && mime != "audio/x-wav" && mime != "audio/x-aiff"))
+        return content_class::compressed;
+    for (auto type : compressed_types)
+        if (mime == type)
+            return content_class::compressed;
+    return content_class::binary;
+}
+
+double compression_policy::sample_entropy(const char *body, std::size_t size) noexcept {
+    static constexpr std::size_t sample_size = 4096;
+    std::array<std::uint32_t, 256> histogram{};
+
+    /* Take the sample from a few places so that a plain text header doesn't hide a packed payload */
+    const std::size_t chunks = size > sample_size ? 4 : 1;
+    const std::size_t chunk_size = std::min(size, sample_size) / chunks;
+    const std::size_t stride = chunks > 1 ? (size - chunk_size) / (chunks - 1) : 0;
+    std::size_t total = 0;
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+        auto begin = body + chunk * stride;
+        for (std::size_t i = 0; i < chunk_size; ++i)
+            ++histogram[static_cast<unsigned char>(begin[i])];
+        total += chunk_size;
+    }
+    if (!total)
+        return 0;
+
+    double entropy = 0;
+    for (auto count : histogram) {
+        if (count) {
+            double p = static_cast<double>(count) / total;
+            entropy -= p * std::log2(p);
+        }
+    }
+    return entropy;
+}
+
+compression_policy::decision compression_policy::decide(const std::string &mime_type, const char *body,
+                                                        std::size_t size) noexcept {
+    const auto &config = storage::config();
+    if (size < config.compression_min_size)
+        return {false, 0};
+
+    switch (classify(mime_type)) {
+    case content_class::text:
+        return {true, config.compression_level_text};
+    case content_class::compressed:
+        return {false, 0};
+    case content_class::binary:
+        if (config.compression_max_entropy > 0 && sample_entropy(body, size) > config.compression_max_entropy)
+            return {false, 0};
+        return {true, config.compression_level_binary};
+    }
+    return {false, 0};
+}
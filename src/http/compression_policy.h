@@ -0,0 +1,48 @@
+/*
+Copyright (C) 2015 Voinea Constantin Vladimir
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+#ifndef COMPRESSION_POLICY_H
+#define COMPRESSION_POLICY_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace http {
+/* Decides whether a body is worth compressing, and how hard to try, from its mime type, its size
+ * and, for types we know nothing about, a sample of its contents.
+ */
+class compression_policy {
+    public:
+    enum class content_class { text, binary, compressed };
+
+    struct decision {
+        bool compress;
+        int level;
+    };
+
+    static content_class classify(const std::string &mime_type) noexcept;
+    static decision decide(const std::string &mime_type, const char *body, std::size_t size) noexcept;
+    static decision decide(const std::string &mime_type, const std::vector<char> &body) noexcept {
+        return decide(mime_type, body.data(), body.size());
+    }
+    static double sample_entropy(const char *body, std::size_t size) noexcept;
+};
+}
+
+#endif // COMPRESSION_POLICY_H
@@ -0,0 +1,203 @@
+/*
+Copyright (C) 2015 Voinea Constantin Vladimir
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+#include <http/content_negotiation.h>
+#include <misc/compression.h>
+
+#include <cctype>
+#include <unordered_map>
+
+using namespace http;
+typedef content_negotiation::coding coding;
+
+namespace {
+/* Bounded, and cleared when full: real traffic has a handful of distinct values */
+constexpr std::size_t max_cached = 256;
+thread_local std::unordered_map<std::string, content_negotiation::preferences> parsed;
+
+struct coding_name {
+    const char *name;
+    coding value;
+};
+
+constexpr coding_name coding_names[] = {{"identity", coding::identity}, {"deflate", coding::deflate},
+                                        {"gzip", coding::gzip},         {"x-gzip", coding::gzip},
+                                        {"br", coding::br},             {"zstd", coding::zstd}};
+}
+
+static bool equal_nocase(const char *begin, const char *end, const char *name) noexcept {
+    for (; begin != end && *name; ++begin, ++name)
+        if (std::tolower(static_cast<unsigned char>(*begin)) != *name)
+            return false;
+    return begin == end && !*name;
+}
+
+static const char *skip_spaces(const char *begin, const char *end) noexcept {
+    while (begin != end && (*begin == ' ' || *begin == '\t'))
+        ++begin;
+    return begin;
+}
+
+/* A qvalue is 0(.ddd)? or 1(.000)?, read straight into thousandths. Anything else reads as 0, like a refusal */
+static std::uint16_t thousandths(const char *begin, const char *end) noexcept {
+    if (begin == end)
+        return 0;
+    if (*begin == '1')
+        return 1000;
+    if (*begin != '0')
+        return 0;
+    std::uint16_t q = 0;
+    if (++begin != end && *begin == '.') {
+        std::uint16_t scale = 100;
+        for (++begin; begin != end && scale && *begin >= '0' && *begin <= '9'; ++begin, scale /= 10)
+            q += static_cast<std::uint16_t>((*begin - '0') * scale);
+    }
+    return q;
+}
+
+/* "q=0.5" among the parameters of one element, 1 when there is none */
+static std::uint16_t quality(const char *begin, const char *end) noexcept {
+    while (begin != end) {
+        begin = skip_spaces(begin + 1, end);
+        if (end - begin > 2 && (begin[0] == 'q' || begin[0] == 'Q') && begin[1] == '=')
+            return thousandths(begin + 2, end);
+        while (begin != end && *begin != ';')
+            ++begin;
+    }
+    return 1000;
+}
+
+content_negotiation::preferences content_negotiation::parse(const std::string &accept_encoding) noexcept {
+    auto cached = parsed.find(accept_encoding);
+    if (cached != parsed.end())
+        return cached->second;
+
+    preferences result;
+    std::array<bool, coding_count> listed{};
+    int wildcard = -1;
+    const char *position = accept_encoding.data();
+    const char *const end = position + accept_encoding.size();
+    while (position != end) {
+        auto element_end = position;
+        while (element_end != end && *element_end != ',')
+            ++element_end;
+        auto name_begin = skip_spaces(position, element_end);
+        auto name_end = name_begin;
+        while (name_end != element_end && *name_end != ';' && *name_end != ' ' && *name_end != '\t')
+            ++name_end;
+        auto params = name_end;
+        while (params != element_end && *params != ';')
+            ++params;
+        const auto q = quality(params, element_end);
+        if (name_end - name_begin == 1 && *name_begin == '*') {
+            wildcard = q;
+        } else {
+            for (const auto &known : coding_names) {
+                if (equal_nocase(name_begin, name_end, known.name)) {
+                    const auto index = static_cast<std::size_t>(known.value);
+                    result.quality[index] = listed[index] ? std::max(result.quality[index], q) : q;
+                    listed[index] = true;
+                }
+            }
+        }
+        position = element_end == end ? end : element_end + 1;
+    }
+    /* Codings that weren't named get what "*" says. identity is fine unless refused outright, but when the client
+     * gave it no q-value at all it only comes after every coding the client does take
+     */
+    for (std::size_t index = 0; index < coding_count; ++index)
+        if (!listed[index] && wildcard >= 0)
+            result.quality[index] = static_cast<std::uint16_t>(wildcard);
+    const auto identity = static_cast<std::size_t>(coding::identity);
+    if (!listed[identity] && wildcard < 0)
+        result.quality[identity] = 1;
+
+    /* Not caching the value only costs parsing it again */
+    try {
+        if (parsed.size() >= max_cached)
+            parsed.clear();
+        parsed.emplace(accept_encoding, result);
+    } catch (...) {
+    }
+    return result;
+}
+
+content_negotiation::preferences content_negotiation::of(const request &r) noexcept {
+    static const std::string none;
+    auto value = r.m_header.get_fields_c().get(http::header::fields::Accept_Encoding);
+    return parse(value ? *value : none);
+}
+
+bool content_negotiation::accepts(const request &r, coding c) noexcept { return of(r).accepts(c); }
+
+coding content_negotiation::choose(const request &r, const coding *offered, std::size_t count) noexcept {
+    const auto client = of(r);
+    /* identity is always on offer, a coding has to be rated above it */
+    coding best = coding::identity;
+    std::uint16_t best_quality = client.quality[static_cast<std::size_t>(coding::identity)];
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto q = client.quality[static_cast<std::size_t>(offered[i])];
+        if (q > best_quality) {
+            best = offered[i];
+            best_quality = q;
+        }
+    }
+    return best;
+}
+
+const char *content_negotiation::name(coding c) noexcept {
+    switch (c) {
+    case coding::deflate:
+        return "deflate";
+    case coding::gzip:
+        return "gzip";
+    case coding::br:
+        return "br";
+    case coding::zstd:
+        return "zstd";
+    case coding::identity:
+        break;
+    }
+    return nullptr;
+}
+
+coding content_negotiation::from_name(const std::string &name) noexcept {
+    for (const auto &known : coding_names)
+        if (equal_nocase(name.data(), name.data() + name.size(), known.name))
+            return known.value;
+    return coding::identity;
+}
+
+bool content_negotiation::can_encode(coding c) noexcept {
+    switch (c) {
+    case coding::br:
+#ifdef VIKING_BROTLI
+        return true;
+#else
+        return false;
+#endif
+    case coding::zstd:
+#ifdef VIKING_ZSTD
+        return true;
+#else
+        return false;
+#endif
+    default:
+        return true;
+    }
+}
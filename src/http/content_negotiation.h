@@ -0,0 +1,64 @@
+/*
+Copyright (C) 2015 Voinea Constantin Vladimir
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+#ifndef CONTENT_NEGOTIATION_H
+#define CONTENT_NEGOTIATION_H
+
+#include <http/request.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+
+namespace http {
+/* Accept-Encoding as RFC 7231 means it: q-values, "*" and identity. Parsed header values are kept per thread,
+ * browsers send the same few strings over and over.
+ */
+class content_negotiation {
+    public:
+    enum class coding : std::uint8_t { identity, deflate, gzip, br, zstd };
+    static constexpr std::size_t coding_count = 5;
+
+    /* The quality (in thousandths) the client gave each coding, 0 for the ones it refuses */
+    struct preferences {
+        std::array<std::uint16_t, coding_count> quality{};
+        bool accepts(coding c) const noexcept { return quality[static_cast<std::size_t>(c)] > 0; }
+    };
+
+    static preferences parse(const std::string &accept_encoding) noexcept;
+    static preferences of(const request &) noexcept;
+    static bool accepts(const request &, coding) noexcept;
+    /* Of the offered codings, the one the client rates highest, ties going to the one offered first. identity when
+     * the client rates it at least as high as each of them, or takes none of them
+     */
+    static coding choose(const request &, const coding *offered, std::size_t count) noexcept;
+    static coding choose(const request &r, std::initializer_list<coding> offered) noexcept {
+        return choose(r, offered.begin(), offered.size());
+    }
+    /* What goes into Content-Encoding, null for identity */
+    static const char *name(coding) noexcept;
+    /* identity for names that aren't a coding */
+    static coding from_name(const std::string &) noexcept;
+    /* Whether responses can be compressed with the coding here, brotli and zstd need their libraries */
+    static bool can_encode(coding) noexcept;
+};
+}
+
+#endif // CONTENT_NEGOTIATION_H
@@ -0,0 +1,155 @@
+/*
+Copyright (C) 2015 Voinea Constantin Vladimir
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+#include <http/content_sniffer.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace http;
+
+namespace {
+struct signature {
+    std::size_t offset;
+    const char *magic;
+    std::size_t size;
+    const char *mime_type;
+};
+
+template <std::size_t N>
+constexpr signature make_signature(std::size_t offset, const char (&magic)[N], const char *mime_type) {
+    return {offset, magic, N - 1, mime_type};
+}
+
+/* Checked in order, so longer signatures sharing a prefix come first */
+constexpr signature signatures[] = {
+    make_signature(0, "\x89PNG\r\n\x1a\n", "image/png"),
+    make_signature(0, "\xff\xd8\xff", "image/jpeg"),
+    make_signature(0, "GIF87a", "image/gif"),
+    make_signature(0, "GIF89a", "image/gif"),
+    make_signature(8, "WEBP", "image/webp"),
+    make_signature(8, "WAVE", "audio/x-wav"),
+    make_signature(0, "II*\0", "image/tiff"),
+    make_signature(0, "MM\0*", "image/tiff"),
+    make_signature(0, "\0\0\1\0", "image/x-icon"),
+    make_signature(0, "%PDF-", "application/pdf"),
+    make_signature(0, "%!PS", "application/postscript"),
+    make_signature(0, "PK\x03\x04", "application/zip"),
+    make_signature(0, "\x1f\x8b", "application/x-gzip"),
+    make_signature(0, "BZh", "application/x-bzip2"),
+    make_signature(0, "\xfd" "7zXZ\0", "application/x-xz"),
+    make_signature(0, "7z\xbc\xaf\x27\x1c", "application/x-7z-compressed"),
+    make_signature(0, "Rar!\x1a\x07", "application/x-rar-compressed"),
+    make_signature(257, "ustar", "application/x-tar"),
+    make_signature(0, "ID3", "audio/mpeg"),
+    make_signature(0, "OggS", "audio/ogg"),
+    make_signature(0, "fLaC", "audio/x-flac"),
+    make_signature(4, "ftyp", "video/mp4"),
+    make_signature(0, "\x1a\x45\xdf\xa3", "video/webm"),
+    make_signature(0, "\0asm", "application/wasm"),
+    make_signature(0, "wOFF", "application/x-font-woff"),
+    make_signature(0, "wOF2", "font/woff2"),
+    make_signature(0, "\x7f" "ELF", "application/octet-stream"),
+};
+
+constexpr const char *default_type = "application/octet-stream";
+}
+
+static bool starts_with_nocase(const char *data, std::size_t size, const char *prefix) noexcept {
+    const auto length = std::strlen(prefix);
+    if (size < length)
+        return false;
+    for (std::size_t i = 0; i < length; ++i)
+        if (std::tolower(static_cast<unsigned char>(data[i])) != prefix[i])
+            return false;
+    return true;
+}
+
+static bool contains(const char *data, std::size_t size, const char *needle) noexcept {
+    const auto length = std::strlen(needle);
+    return std::search(data, data + size, needle, needle + length) != data + size;
+}
+
+static bool looks_like_text(const char *data, std::size_t size) noexcept {
+    for (std::size_t i = 0; i < size; ++i) {
+        const auto c = static_cast<unsigned char>(data[i]);
+        if (c < 0x20 && c != '\t' && c != '\n' && c != '\r' && c != '\f' && c != 0x1b)
+            return false;
+    }
+    return true;
+}
+
+static const char *sniff_text(const char *data, std::size_t size) noexcept {
+    if (size >= 3 && !std::memcmp(data, "\xef\xbb\xbf", 3)) {
+        data += 3;
+        size -= 3;
+    }
+    while (size && std::isspace(static_cast<unsigned char>(*data))) {
+        ++data;
+        --size;
+    }
+    if (!size || !looks_like_text(data, size))
+        return nullptr;
+    for (auto tag : {"<!doctype html", "<html", "<head", "<body", "<!--", "<script", "<title", "<div", "<p>"})
+        if (starts_with_nocase(data, size, tag))
+            return "text/html";
+    const bool xml = starts_with_nocase(data, size, "<?xml");
+    if (starts_with_nocase(data, size, "<svg") || (xml && contains(data, size, "<svg")))
+        return "image/svg+xml";
+    if (xml)
+        return "application/xml";
+    if (data[0] == '{' || data[0] == '[') {
+        /* An object opens with a key or closes right away, an array holds anything but the rest of a sentence */
+        std::size_t next = 1;
+        while (next < size && std::isspace(static_cast<unsigned char>(data[next])))
+            ++next;
+        const unsigned char c = next == size ? 0 : data[next];
+        if (next == size || c == '"' || c == '}' || (data[0] == '[' && !std::isalpha(c)))
+            return "application/json";
+    }
+    if (size > 2 && data[0] == '#' && data[1] == '!')
+        return contains(data, std::min<std::size_t>(size, 64), "sh") ? "application/x-sh" : "text/plain";
+    return "text/plain";
+}
+
+std::string content_sniffer::sniff(const char *data, std::size_t size) noexcept {
+    for (const auto &s : signatures)
+        if (size >= s.offset + s.size && !std::memcmp(data + s.offset, s.magic, s.size))
+            return s.mime_type;
+    /* "BM" alone would take plenty of text files for bitmaps, the reserved header fields have to be zero too */
+    if (size >= 14 && data[0] == 'B' && data[1] == 'M' && !std::memcmp(data + 6, "\0\0\0\0", 4))
+        return "image/bmp";
+    if (auto text = sniff_text(data, size))
+        return text;
+    return default_type;
+}
+
+std::string content_sniffer::sniff_file(const fs::path &path) noexcept {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (-1 == fd)
+        return "";
+    char buffer[sniff_size];
+    const auto read = ::pread64(fd, buffer, sizeof(buffer), 0);
+    ::close(fd);
+    if (read < 0)
+        return "";
+    return sniff(buffer, static_cast<std::size_t>(read));
+}
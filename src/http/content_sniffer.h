@@ -0,0 +1,44 @@
+/*
+Copyright (C) 2015 Voinea Constantin Vladimir
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+#ifndef CONTENT_SNIFFER_H
+#define CONTENT_SNIFFER_H
+
+#include <io/filesystem.h>
+
+#include <cstddef>
+#include <string>
+
+namespace http {
+/* Tells the type of files without an extension from their first bytes, the way file(1) would for the types a
+ * web server usually meets: images, audio and video, PDF, archives, fonts, HTML, XML and JSON.
+ */
+class content_sniffer {
+    public:
+    /* How much of a file is looked at */
+    static constexpr std::size_t sniff_size = 512;
+
+    static std::string sniff(const char *data, std::size_t size) noexcept;
+    /* Reads the start of the file every time, the result is kept with the file's path_cache entry. Empty when the
+     * file can't be read
+     */
+    static std::string sniff_file(const fs::path &) noexcept;
+};
+}
+
+#endif // CONTENT_SNIFFER_H
@@ -0,0 +1,111 @@
+/*
+Copyright (C) 2015 Voinea Constantin Vladimir
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+#include <http/compression_policy.h>
+#include <http/content_negotiation.h>
+#include <http/delivery_policy.h>
+#include <misc/storage.h>
+
+#include <algorithm>
+#include <atomic>
+
+#include <unistd.h>
+
+using namespace http;
+
+/* Every reactor counts into these, stats() reads them from anywhere */
+static std::array<std::atomic<std::uint64_t>, delivery_policy::strategy_count> chosen_counts{};
+static std::array<std::atomic<std::uint64_t>, delivery_policy::strategy_count> chosen_bytes{};
+
+/* Request counts per path, a small count-min sketch: each row counts a path under a different slice of its hash,
+ * and the smallest of its counters is the estimate, so a collision only over-counts when it happens in every row.
+ * Every counter is halved once in a while so that the estimate follows the recent past rather than the whole
+ * uptime. Each reactor keeps its own, a path is hot when the thread serving it sees it often.
+ */
+static constexpr std::size_t sketch_rows = 4;
+static constexpr std::size_t sketch_width = 1024;
+static thread_local std::array<std::array<std::uint8_t, sketch_width>, sketch_rows> frequencies{};
+static thread_local std::uint32_t increments = 0;
+static constexpr std::uint32_t aging_period = 8 * sketch_rows * sketch_width;
+
+static std::uint32_t record(const fs::path &path) noexcept {
+    const std::uint64_t hash = std::hash<std::string>{}(path.native());
+    std::uint32_t estimate = UINT8_MAX;
+    for (std::size_t row = 0; row < sketch_rows; ++row) {
+        auto &counter = frequencies[row][(hash >> (row * 16)) % sketch_width];
+        if (counter < UINT8_MAX)
+            ++counter;
+        estimate = std::min<std::uint32_t>(estimate, counter);
+    }
+    if (++increments == aging_period) {
+        increments = 0;
+        for (auto &row : frequencies)
+            for (auto &c : row)
+                c >>= 1;
+    }
+    return estimate;
+}
+
+delivery_policy::strategy delivery_policy::standard(const candidate &c) noexcept {
+    static const auto page_size = static_cast<std::uintmax_t>(getpagesize());
+    const auto &config = storage::config();
+    if (c.has_precompressed)
+        return strategy::precompressed;
+    /* For a page or less the syscalls of sendfile cost more than the copy */
+    if (c.size <= page_size)
+        return strategy::memory;
+    /* A single file shouldn't be able to push a good part of the cache out */
+    if (c.size > config.cache_byte_budget / 16)
+        return strategy::sendfile;
+    /* The compressed variant is computed once and saves bytes on every later response */
+    if (c.compressible && c.accepts_compression && config.enable_compression)
+        return strategy::memory;
+    if (c.size <= config.delivery_memory_max_size && c.frequency >= config.delivery_hot_threshold)
+        return strategy::memory;
+    return strategy::sendfile;
+}
+
+delivery_policy::strategy delivery_policy::choose(const http::request &request, const fs::path &path,
+                                                  const std::string &mime_type, std::uintmax_t size,
+                                                  bool has_precompressed) noexcept {
+    using coding = content_negotiation::coding;
+    const auto &config = storage::config();
+    const auto preferences = content_negotiation::of(request);
+    candidate c{path,
+                size,
+                record(path),
+                compression_policy::classify(mime_type) == compression_policy::content_class::text,
+                preferences.accepts(coding::deflate) || preferences.accepts(coding::gzip),
+                has_precompressed};
+    auto chosen = config.delivery_cb ? config.delivery_cb(c) : standard(c);
+    if (chosen == strategy::precompressed && !has_precompressed)
+        chosen = strategy::sendfile;
+    auto index = static_cast<std::size_t>(chosen);
+    chosen_counts[index].fetch_add(1, std::memory_order_relaxed);
+    chosen_bytes[index].fetch_add(size, std::memory_order_relaxed);
+    return chosen;
+}
+
+delivery_policy::statistics delivery_policy::stats() noexcept {
+    statistics result;
+    for (std::size_t i = 0; i < strategy_count; ++i) {
+        result.chosen[i] = chosen_counts[i].load(std::memory_order_relaxed);
+        result.bytes[i] = chosen_bytes[i].load(std::memory_order_relaxed);
+    }
+    return result;
+}
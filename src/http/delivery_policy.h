@@ -0,0 +1,65 @@
+/*
+Copyright (C) 2015 Voinea Constantin Vladimir
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+#ifndef DELIVERY_POLICY_H
+#define DELIVERY_POLICY_H
+
+#include <http/request.h>
+#include <io/filesystem.h>
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace http {
+/* Decides how a static file goes out: from the in-memory cache (which also holds its compressed
+ * variants), straight from the disk with sendfile, or as a precompressed sibling. The standard rules
+ * weigh the size, how often the file was asked for lately, whether its type compresses, whether the
+ * client accepts compression and the cache budget. configuration::delivery_cb replaces them.
+ */
+class delivery_policy {
+    public:
+    enum class strategy : std::uint8_t { memory, sendfile, precompressed };
+    static constexpr std::size_t strategy_count = 3;
+
+    struct candidate {
+        const fs::path &path;
+        std::uintmax_t size;
+        /* Recent requests for the path, an estimate that decays over time */
+        std::uint32_t frequency;
+        bool compressible;
+        bool accepts_compression;
+        bool has_precompressed;
+    };
+
+    struct statistics {
+        std::array<std::uint64_t, strategy_count> chosen{};
+        std::array<std::uint64_t, strategy_count> bytes{};
+    };
+
+    typedef std::function<strategy(const candidate &)> chooser;
+
+    static strategy choose(const http::request &, const fs::path &, const std::string &mime_type,
+                           std::uintmax_t size, bool has_precompressed) noexcept;
+    static strategy standard(const candidate &) noexcept;
+    static statistics stats() noexcept;
+};
+}
+
+#endif // DELIVERY_POLICY_H
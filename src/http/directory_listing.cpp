@@ -17,64 +17,214 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 
 */
 #include "directory_listing.h"
+#include <cache/path_cache.h>
 #include <inl/status_codes.h>
-#include <iomanip>
 #include <misc/storage.h>
-#include <sstream>
+
+#include <algorithm>
+#include <cstdlib>
+#include <dirent.h>
+#include <list>
 #include <string>
+#include <sys/stat.h>
+#include <unordered_map>
+#include <vector>
 
-static std::string trim_quotes(std::string str) {
-    if (str.front() == '\"')
-        str = str.substr(1, str.size());
-    if (str.back() == '\"')
-        str = str.substr(0, str.size());
-    return str;
-}
+/* Listings are rendered once per version of a directory, which its mtime tells apart */
+struct listing {
+    std::int64_t mtime = 0;
+    /* One rendered link per entry, sorted by name */
+    std::vector<std::string> rows;
+};
+
+/* How many directories keep their rendered listing, least recently used go first */
+static constexpr std::size_t cached_listings = 64;
 
-static std::string url_encode(const std::string &value) {
-    std::ostringstream escaped;
-    escaped.fill('0');
-    escaped << std::hex;
+typedef std::list<std::pair<std::string, listing>> listing_list;
+/* Most recently used at the front */
+static listing_list listings;
+static std::unordered_map<std::string, listing_list::iterator> by_directory;
 
-    for (std::string::const_iterator i = value.begin(), n = value.end(); i != n; ++i) {
-        std::string::value_type c = (*i);
+static const char hex_digits[] = "0123456789ABCDEF";
 
+static void append_url_encoded(std::string &out, const std::string &value) {
+    for (unsigned char c : value) {
         // Keep alphanumeric and other accepted characters intact
         if (isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~') {
-            escaped << c;
+            out += static_cast<char>(c);
             continue;
         }
-
         // Any other characters are percent-encoded
-        escaped << std::uppercase;
-        escaped << '%' << std::setw(2) << int((unsigned char)c);
-        escaped << std::nouppercase;
+        out += '%';
+        out += hex_digits[c >> 4];
+        out += hex_digits[c & 15];
+    }
+}
+
+static void append_html_escaped(std::string &out, const std::string &value) {
+    for (char c : value) {
+        switch (c) {
+        case '&':
+            out += "&amp;";
+            break;
+        case '<':
+            out += "&lt;";
+            break;
+        case '>':
+            out += "&gt;";
+            break;
+        case '"':
+            out += "&quot;";
+            break;
+        default:
+            out += c;
+        }
+    }
+}
+
+static std::string hex(std::uint64_t number) {
+    std::string result;
+    do {
+        result += hex_digits[number & 15];
+        number >>= 4;
+    } while (number);
+    std::reverse(result.begin(), result.end());
+    return result;
+}
+
+/* readdir() instead of fs::directory_iterator, which builds a path per entry and may stat it */
+static bool read_directory(const std::string &directory, std::vector<std::string> &names) {
+    DIR *dir = ::opendir(directory.c_str());
+    if (!dir)
+        return false;
+    while (auto *entry = ::readdir(dir)) {
+        const char *name = entry->d_name;
+        if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
+            continue;
+        names.emplace_back(name);
     }
+    ::closedir(dir);
+    std::sort(names.begin(), names.end());
+    return true;
+}
 
-    return escaped.str();
+static void render(const std::string &directory, listing &l) {
+    std::vector<std::string> names;
+    if (!read_directory(directory, names))
+        throw http::status_code::NotFound;
+    l.rows.clear();
+    l.rows.reserve(names.size());
+    for (const auto &name : names) {
+        std::string row = "<a href=\"";
+        append_url_encoded(row, name);
+        row += "\">";
+        append_html_escaped(row, name);
+        row += "</a><br/>";
+        l.rows.emplace_back(std::move(row));
+    }
+}
+
+static const listing &find_listing(const std::string &directory) {
+    struct stat64 stat;
+    if (-1 == ::stat64(directory.c_str(), &stat) || !S_ISDIR(stat.st_mode))
+        throw http::status_code::NotFound;
+    const std::int64_t mtime = stat.st_mtim.tv_sec * 1000000000ll + stat.st_mtim.tv_nsec;
+
+    auto it = by_directory.find(directory);
+    if (it != by_directory.end()) {
+        listings.splice(listings.begin(), listings, it->second);
+    } else {
+        while (listings.size() >= cached_listings) {
+            by_directory.erase(listings.back().first);
+            listings.pop_back();
+        }
+        listings.emplace_front(directory, listing{});
+        it = by_directory.emplace(directory, listings.begin()).first;
+    }
+    auto &cached = it->second->second;
+    if (cached.mtime != mtime || cached.rows.empty()) {
+        try {
+            render(directory, cached);
+        } catch (...) {
+            by_directory.erase(it);
+            listings.pop_front();
+            throw;
+        }
+        cached.mtime = mtime;
+    }
+    return cached;
+}
+
+/* The page parameter of the query, not anything that merely ends with it like homepage= */
+static std::size_t requested_page(const std::string &url) noexcept {
+    static constexpr char name[] = "page=";
+    constexpr auto length = sizeof(name) - 1;
+    auto parameter = url.find('?');
+    while (parameter != std::string::npos) {
+        ++parameter;
+        if (url.compare(parameter, length, name) == 0)
+            return std::strtoul(url.c_str() + parameter + length, nullptr, 10);
+        parameter = url.find('&', parameter);
+    }
+    return 1;
+}
+
+static bool matches(const http::request &req, const std::string &tag) noexcept {
+    auto value = req.m_header.get_fields_c().get(http::header::fields::If_None_Match);
+    return value && (value->find(tag) != std::string::npos || *value == "*");
 }
 
 http::response http::list_directory(const http::request &req) {
     auto root_path = storage::config().root_path;
     try {
-        if (req.url.back() != '/') {
+        const auto path = req.url.substr(0, req.url.find('?'));
+        std::string normalized;
+        if (path.empty() || !cache::path_cache::normalize(path, normalized))
+            throw http::status_code::NotFound;
+        if (path.back() != '/') {
             http::response r{req, http::status_code::Found};
-            r.set("Location", req.url + '/');
+            r.set("Location", path + '/' + req.url.substr(path.size()));
+            r.set("Cache-Control", "no-cache");
+            return r;
+        }
+        const auto &l = find_listing(root_path + normalized);
+
+        const auto page_size = storage::config().directory_page_size ?: std::max<std::size_t>(l.rows.size(), 1);
+        const auto pages = std::max<std::size_t>((l.rows.size() + page_size - 1) / page_size, 1);
+        const auto page = requested_page(req.url);
+        if (page < 1 || page > pages)
+            throw http::status_code::NotFound;
+
+        const auto tag = '"' + hex(static_cast<std::uint64_t>(l.mtime)) + '-' + hex(l.rows.size()) + '-' +
+                         std::to_string(page) + '"';
+        if (matches(req, tag)) {
+            http::response r{req, http::status_code::NotModified};
+            r.set("ETag", tag);
             r.set("Cache-Control", "no-cache");
             return r;
         }
-        fs::path root = root_path + req.url;
-        std::ostringstream stream;
-        stream << "<h1>Directory listing of " + req.url + "</h1>";
-        for (auto it : fs::directory_iterator(root)) {
-            fs::path p = it;
-            stream << "<a href=\"";
-            stream << url_encode(trim_quotes(p.filename())) << "\">";
-            stream << trim_quotes(p.filename());
-            stream << "</a><br/>";
+
+        const auto begin = l.rows.begin() + (page - 1) * page_size;
+        const auto end = l.rows.begin() + std::min(page * page_size, l.rows.size());
+        std::string body = "<h1>Directory listing of ";
+        append_html_escaped(body, path);
+        body += "</h1>";
+        for (auto row = begin; row != end; ++row)
+            body += *row;
+        if (pages > 1) {
+            body += "<p>";
+            if (page > 1)
+                body += "<a href=\"?page=" + std::to_string(page - 1) + "\">Previous</a> ";
+            body += "Page " + std::to_string(page) + " of " + std::to_string(pages);
+            if (page < pages)
+                body += " <a href=\"?page=" + std::to_string(page + 1) + "\">Next</a>";
+            body += "</p>";
         }
-        http::response r{req, stream.str()};
+
+        http::response r{req, body};
         r.set("Content-Type", "text/html; charset=utf-8");
+        /* Stored, but revalidated with the ETag before every use */
+        r.set("ETag", tag);
         r.set("Cache-Control", "no-cache");
         return r;
     } catch (...) {
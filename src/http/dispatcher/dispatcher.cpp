@@ -17,8 +17,13 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 
 */
 #include <algorithm>
+#include <cache/bundle.h>
 #include <cache/file_descriptor.h>
+#include <cache/path_cache.h>
+#include <cache/precompressed.h>
 #include <cache/resource_cache.h>
+#include <cache/watcher.h>
+#include <http/delivery_policy.h>
 #include <http/dispatcher/dispatcher.h>
 #include <http/engine.h>
 #include <http/engine.h>
@@ -31,13 +36,44 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include <io/filesystem.h>
 #include <io/socket/socket.h>
 #include <misc/common.h>
+#include <misc/date.h>
 #include <misc/debug.h>
 #include <misc/storage.h>
+#include <misc/thread_pool.h>
 #include <type_traits>
 
 using namespace web;
 using namespace cache;
 static response_serializer serializer;
+/* Cached bodies from this size on are handed to the scheduler by reference instead of being copied */
+static constexpr std::size_t shared_body_threshold = 16 * 1024;
+
+/* A large generated body is moved behind its header instead of being copied into one buffer with it, the scheduler
+ * writes the pieces out with a single sendmsg
+ */
+static schedule_item serialize(http::response &response) {
+    if (response.get_type() != http::response::type::text || response.get_text().size() < shared_body_threshold)
+        return {serializer(response), response.get_keep_alive()};
+    schedule_item item{response.get_keep_alive()};
+    item.put_back(std::make_unique<io::memory_buffer>(serializer.make_header(response)));
+    item.put_back(std::make_unique<io::memory_buffer>(response.release_text()));
+    item.put_back(std::make_unique<io::memory_buffer>(serializer.make_ending(response)));
+    return item;
+}
+
+/* Both pools are started on first use and keep the size the configuration had then. They only get used once their
+ * setting is non-zero, but that may be after a set_config turned it on, so they always get at least one worker:
+ * a task submitted to an empty pool would never run and its channel would wait behind it forever
+ */
+static thread_pool &loaders() {
+    static thread_pool pool{std::max<std::size_t>(storage::config().cold_load_threads, 1)};
+    return pool;
+}
+
+static thread_pool &compressors() {
+    static thread_pool pool{std::max<std::size_t>(storage::config().compression_threads, 1)};
+    return pool;
+}
 
 class dispatcher::dispatcher_impl {
     route_map routes;
@@ -45,14 +81,43 @@ class dispatcher::dispatcher_impl {
     typedef std::unordered_map<const io::channel *, ctx_ptr> transaction_map;
     transaction_map unfinished_transactions;
 
+    /* A response that a handler or the compression pool is still working on */
+    struct pending_response : public async_buffer<http::response> {
+        pending_response(std::future<http::response> future) : async_buffer<http::response>(std::move(future)) {}
+        schedule_item resolve() noexcept {
+            auto http_response = future.get();
+            /* Only when a handler built its response on the reactor and handed it over through a future. The
+             * channel then waits once more, behind the compression pool, instead of the reactor doing the work
+             */
+            if (http_response.compression_pending())
+                return compress_in_background(std::move(http_response));
+            return serialize(http_response);
+        }
+    };
+
+    /* A cache miss being read on a loader thread. The channel waits behind it like behind any other future */
+    struct cold_load : public async_buffer<resource> {
+        const dispatcher_impl &owner;
+        http::request request;
+        cold_load(const dispatcher_impl &owner, const http::request &request, std::future<resource> future)
+            : async_buffer<resource>(std::move(future)), owner(owner), request(request) {}
+        schedule_item resolve() noexcept { return owner.finish_cold_load(*this); }
+    };
+
     public:
-    dispatcher_impl() = default;
+    dispatcher_impl() {
+        watcher::subscribe(path_cache::invalidate);
+        watcher::subscribe(resource_cache::invalidate);
+        watcher::subscribe(file_descriptor::invalidate);
+    }
 
     inline void add_route(route r) noexcept { routes.push_back(r); }
 
-    inline std::unique_ptr<io::memory_buffer> handle_barrier(async_buffer<http::response> *r) noexcept {
-        auto http_response = r->future.get();
-        return std::make_unique<io::memory_buffer>(serializer(http_response));
+    inline schedule_item handle_barrier(data_source *source) noexcept {
+        auto *pending = dynamic_cast<barrier *>(source);
+        if (pending && pending->is_ready())
+            return pending->resolve();
+        return {};
     }
 
     inline schedule_item handle_connection(io::channel *connection) {
@@ -80,34 +145,106 @@ class dispatcher::dispatcher_impl {
 
     private:
     schedule_item process_request(const http::request &r) const noexcept {
+        watcher::dispatch();
         if (http::util::is_passable(r))
             if (auto user_handler = route_util::get_user_handler(r, routes))
                 return pass_request(r, user_handler);
-        if (http::util::is_disk_resource(r))
-            return take_disk_resource(r);
+        if (auto packed = bundle::find(r))
+            return take_bundle_entry(r, packed);
+        if (auto resolved = path_cache::resolve(r.url))
+            return take_disk_resource(r, resolved);
         return not_found(r);
     }
 
     inline schedule_item take_folder(const http::request &request) const {
         auto &folder_cb = storage::config().folder_cb;
         auto resolution = folder_cb(request);
-        return {serializer(resolution.get_response()), resolution.get_response().get_keep_alive()};
+        return serialize(resolution.get_response());
     }
 
     schedule_item take_file_from_memory(const http::request &request, fs::path full_path) const {
-        if (auto resource = resource_cache::aquire(full_path)) {
-            http::response response{request, resource};
-            return {serializer(response), response.get_keep_alive()};
-        } else {
-            throw http::status_code::NotFound;
+        if (auto cached = resource_cache::find(full_path))
+            return send_cached(request, cached);
+        if (storage::config().cold_load_threads)
+            return load_in_background(request, full_path);
+        if (auto loaded = resource_cache::store(resource{full_path}))
+            return send_cached(request, loaded);
+        throw http::status_code::NotFound;
+    }
+
+    schedule_item send_cached(const http::request &request, const resource &cached) const {
+        auto response = http::response::from_cache(request, cached);
+        if (response.unchanged()) {
+            auto not_modified = response.not_modified();
+            return {serializer(not_modified), not_modified.get_keep_alive()};
         }
+        const bool large = response.content_len() >= shared_body_threshold;
+        /* A body that went into a memfd is only there, even if cache_in_memfd was turned off since */
+        auto memfd = large && (storage::config().cache_in_memfd || !response.shared_body()) ? response.sealed_body()
+                                                                                            : nullptr;
+        if (!response.get_resource().same_variants(cached))
+            resource_cache::update(response.get_resource());
+        if (memfd)
+            return send_sealed_body(std::move(memfd), response);
+        if (large)
+            return send_shared_body(response);
+        return {serializer(response), response.get_keep_alive()};
+    }
+
+    /* Reading a file can block on the disk for a long time, so misses are read on a loader thread */
+    schedule_item load_in_background(const http::request &request, const fs::path &full_path) const {
+        auto future = loaders().submit([full_path]() { return resource{full_path}; });
+        schedule_item item;
+        item.put_back(std::make_unique<cold_load>(*this, request, std::move(future)));
+        return item;
+    }
+
+    /* Back on the reactor: the cache and the response are only touched from here. Sent like any other hit, so
+     * a large file goes out by reference or from its memfd
+     */
+    schedule_item finish_cold_load(cold_load &load) const noexcept {
+        try {
+            if (auto loaded = resource_cache::store(load.future.get()))
+                return send_cached(load.request, loaded);
+        } catch (...) {
+        }
+        http::response response{load.request, http::status_code::NotFound};
+        response.set("Cache-Control", "no-cache");
+        return {serializer(response), response.get_keep_alive()};
+    }
+
+    static io::unix_file::access_hints stream_hints(std::uintmax_t size) noexcept {
+        const auto &config = storage::config();
+        io::unix_file::access_hints hints;
+        hints.sequential = size >= config.stream_sequential_min_size;
+        hints.readahead = hints.sequential ? config.stream_readahead : 0;
+        hints.drop_behind = config.stream_drop_behind_min_size && size >= config.stream_drop_behind_min_size;
+        return hints;
     }
 
-    schedule_item take_unix_file(const http::request &r, fs::path full_path) const {
-        auto unix_file =
-            std::make_unique<io::unix_file>(full_path, cache::file_descriptor::aquire, cache::file_descriptor::release);
+    schedule_item take_unix_file(const http::request &r, const path_cache::entry &file, bool varies = false) const {
+        auto unix_file = std::make_unique<io::unix_file>(file.path, file_descriptor::aquire, file_descriptor::release,
+                                                         file_descriptor::size);
+        unix_file->advise(stream_hints(unix_file->size));
+        http::response http_response(r, unix_file.get(), file.mime_type);
+        if (varies)
+            http_response.set(http::header::fields::Vary, "Accept-Encoding");
+        return send_unix_file(std::move(unix_file), http_response);
+    }
+
+    schedule_item take_precompressed_file(const http::request &r, const path_cache::entry &file,
+                                          const precompressed::variant &variant) const {
+        auto unix_file = std::make_unique<io::unix_file>(variant.path, file_descriptor::aquire,
+                                                         file_descriptor::release, file_descriptor::size);
+        unix_file->advise(stream_hints(unix_file->size));
+        http::response http_response(r, unix_file.get(), file.mime_type);
+        http_response.set(http::header::fields::Content_Encoding, variant.encoding);
+        http_response.set(http::header::fields::Vary, "Accept-Encoding");
+        return send_unix_file(std::move(unix_file), http_response);
+    }
+
+    schedule_item send_unix_file(std::unique_ptr<io::unix_file> unix_file, const http::response &http_response) const {
         schedule_item scheduler_item;
-        http::response http_response(r, unix_file.get());
         scheduler_item.put_back(std::make_unique<io::memory_buffer>(serializer.make_header(http_response)));
         scheduler_item.put_back(std::move(unix_file));
         scheduler_item.put_back(std::make_unique<io::memory_buffer>(serializer.make_ending(http_response)));
@@ -115,21 +252,96 @@ class dispatcher::dispatcher_impl {
         return scheduler_item;
     }
 
-    inline schedule_item take_regular_file(const http::request &request, fs::path full_path) const {
-        if (should_copy(request, full_path)) {
-            return take_file_from_memory(request, full_path);
-        } else {
-            return take_unix_file(request, full_path);
+    schedule_item send_sealed_body(resource::memfd memfd, const http::response &http_response) const {
+        const int fd = memfd->fd();
+        const auto size = static_cast<off64_t>(memfd->size());
+        /* The release function holds the memfd, so it outlives the transfer even if the cache drops it */
+        auto unix_file = std::make_unique<io::unix_file>(http_response.get_resource().path().string(),
+                                                         [fd](const std::string &) { return fd; },
+                                                         [memfd](int) {}, [size](int) { return size; });
+        return send_unix_file(std::move(unix_file), http_response);
+    }
+
+    schedule_item send_shared_body(const http::response &http_response) const {
+        schedule_item scheduler_item;
+        scheduler_item.put_back(std::make_unique<io::memory_buffer>(serializer.make_header(http_response)));
+        scheduler_item.put_back(std::make_unique<io::shared_buffer>(http_response.shared_body()));
+        scheduler_item.put_back(std::make_unique<io::memory_buffer>(serializer.make_ending(http_response)));
+        scheduler_item.set_keep_file_open(http_response.get_keep_alive());
+        return scheduler_item;
+    }
+
+    /* Small files are copied out of the mapping right behind their header, larger ones are sent with sendfile */
+    schedule_item take_bundle_entry(const http::request &request, const bundle::entry &entry) const {
+        if (http::response::unchanged_for(request, entry.etag, entry.last_write)) {
+            http::response http_response{request, http::status_code::NotModified};
+            http_response.set(http::header::fields::ETag, entry.etag);
+            http_response.set(http::header::fields::Last_Modified, date(entry.last_write).to_string());
+            if (entry.varies)
+                http_response.set(http::header::fields::Vary, "Accept-Encoding");
+            return {serializer(http_response), http_response.get_keep_alive()};
+        }
+        if (entry.length < shared_body_threshold) {
+            http::response http_response{request, http::status_code::OK};
+            set_bundle_fields(http_response, entry);
+            auto header = serializer.make_header(http_response);
+            auto ending = serializer.make_ending(http_response);
+            header.reserve(header.size() + entry.length + ending.size());
+            header.insert(header.end(), entry.data, entry.data + entry.length);
+            header.insert(header.end(), ending.begin(), ending.end());
+            return {std::move(header), http_response.get_keep_alive()};
         }
+        const int fd = entry.fd;
+        const auto end = entry.offset + static_cast<off64_t>(entry.length);
+        /* The release function holds the mapping, so a bundle deployed meanwhile doesn't close the descriptor */
+        auto unix_file = std::make_unique<io::unix_file>(storage::config().bundle_path,
+                                                         [fd](const std::string &) { return fd; },
+                                                         [owner = entry.owner](int) {}, [end](int) { return end; });
+        unix_file->restrict_to(entry.offset, static_cast<off64_t>(entry.length));
+        unix_file->advise(stream_hints(entry.length));
+        http::response http_response(request, unix_file.get(), entry.mime_type);
+        set_bundle_fields(http_response, entry);
+        return send_unix_file(std::move(unix_file), http_response);
     }
 
-    inline schedule_item take_disk_resource(const http::request &request) const noexcept {
-        auto full_path = storage::config().root_path + request.url;
+    static void set_bundle_fields(http::response &http_response, const bundle::entry &entry) {
+        http_response.set(http::header::fields::Content_Type, entry.mime_type);
+        http_response.set(http::header::fields::ETag, entry.etag);
+        http_response.set(http::header::fields::Last_Modified, date(entry.last_write).to_string());
+        http_response.set(http::header::fields::Content_Length, std::to_string(entry.length));
+        if (entry.encoding)
+            http_response.set(http::header::fields::Content_Encoding, entry.encoding);
+        if (entry.varies)
+            http_response.set(http::header::fields::Vary, "Accept-Encoding");
+    }
+
+    inline schedule_item take_regular_file(const http::request &request, const path_cache::entry &file) const {
+        using strategy = http::delivery_policy::strategy;
+        auto variant = precompressed::find(request, file);
+        switch (http::delivery_policy::choose(request, file.path, file.mime_type, file.size,
+                                              static_cast<bool>(variant))) {
+        case strategy::precompressed:
+            return take_precompressed_file(request, file, variant);
+        case strategy::memory:
+            /* The cached identity body carries no Vary, and shared caches must not hand it to clients that can
+             * take a sibling
+             */
+            if (!variant.varies)
+                return take_file_from_memory(request, file.path);
+            break;
+        case strategy::sendfile:
+            break;
+        }
+        return take_unix_file(request, file, variant.varies);
+    }
+
+    inline schedule_item take_disk_resource(const http::request &request,
+                                            const path_cache::entry &resolved) const noexcept {
         try {
-            if (fs::is_directory(full_path)) {
+            if (resolved.type == path_cache::kind::directory) {
                 return take_folder(request);
-            } else if (fs::is_regular_file(full_path)) {
-                return take_regular_file(request, full_path);
+            } else if (resolved.type == path_cache::kind::file) {
+                return take_regular_file(request, resolved);
             }
         } catch (...) {
         }
@@ -137,26 +349,29 @@ class dispatcher::dispatcher_impl {
     }
 
     inline schedule_item pass_request(const http::request &req, http_handler h) const noexcept {
+        http::response::defer_compression(true);
         http::resolution resolution = h(req);
-        if (resolution.get_type() == http::resolution::type::sync)
-            return {serializer(resolution.get_response()), resolution.get_response().get_keep_alive()};
-        else
-            return {std::make_unique<async_buffer<http::response>>(std::move(resolution.get_future()))};
+        http::response::defer_compression(false);
+        if (resolution.get_type() == http::resolution::type::sync) {
+            auto &response = resolution.get_response();
+            if (response.compression_pending())
+                return compress_in_background(std::move(response));
+            return serialize(response);
+        } else
+            return {std::make_unique<pending_response>(std::move(resolution.get_future()))};
     }
 
-    bool should_copy(const http::request &, const fs::path &resource_path) const {
-        try {
-            static auto page_size = static_cast<std::size_t>(getpagesize());
-            auto file_size = fs::file_size(resource_path);
-            if (file_size < 2000000 && io::get_extension(resource_path.string()) == "jpg")
-                return true;
-            if (file_size <= page_size)
-                return true;
-
-            return false;
-        } catch (...) {
-            throw http::status_code::NotFound;
-        }
+    /* A large generated body would hold up every other connection while being compressed. The channel waits for
+     * it like for a handler's future
+     */
+    static schedule_item compress_in_background(http::response &&response) {
+        schedule_item item{response.get_keep_alive()};
+        auto future = compressors().submit([response = std::move(response)]() mutable {
+            response.finish_compression(compressors());
+            return response;
+        });
+        item.put_back(std::make_unique<pending_response>(std::move(future)));
+        return item;
     }
 
     inline schedule_item not_found(const http::request &r) const noexcept {
@@ -176,7 +391,7 @@ schedule_item dispatcher::handle_connection(io::channel *connection) const {
     }
 }
 
-std::unique_ptr<io::memory_buffer> dispatcher::handle_barrier(async_buffer<http::response> *item) noexcept {
+schedule_item dispatcher::handle_barrier(data_source *item) noexcept {
     return impl->handle_barrier(item);
 }
 
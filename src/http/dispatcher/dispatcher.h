@@ -43,7 +43,8 @@ class dispatcher {
 
     void add_route(route) noexcept;
     schedule_item handle_connection(io::channel *) const;
-    std::unique_ptr<io::memory_buffer> handle_barrier(async_buffer<http::response> *) noexcept;
+    /* Any asynchronous source at the front of a queue. An empty item means it isn't ready yet */
+    schedule_item handle_barrier(data_source *) noexcept;
     void will_remove(io::channel *) noexcept;
 };
 }
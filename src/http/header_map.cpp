@@ -0,0 +1,161 @@
+/*
+Copyright (C) 2015 Voinea Constantin Vladimir
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+#include <http/header_map.h>
+#include <misc/common.h>
+#include <strings.h>
+
+using namespace http;
+
+namespace {
+struct field_name_entry {
+    const char *name;
+    std::size_t size;
+};
+
+#define VIKING_FIELD_NAME(id, name) {name, sizeof(name) - 1},
+const field_name_entry field_names[known_field_count] = {VIKING_HEADER_FIELDS(VIKING_FIELD_NAME)};
+#undef VIKING_FIELD_NAME
+
+constexpr std::size_t intern_table_size = 256;
+
+inline std::uint32_t folded_hash(const char *name, std::size_t size) noexcept {
+    std::uint32_t hash = 2166136261u;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(name[i]) | 0x20;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/* Open addressing table from folded name hash to field_id + 1. 256 slots for ~80 names keeps the
+ * probe sequences short */
+std::array<std::uint8_t, intern_table_size> make_intern_table() noexcept {
+    std::array<std::uint8_t, intern_table_size> table{};
+    for (std::size_t id = 0; id < known_field_count; ++id) {
+        auto slot = folded_hash(field_names[id].name, field_names[id].size) % intern_table_size;
+        while (table[slot])
+            slot = (slot + 1) % intern_table_size;
+        table[slot] = static_cast<std::uint8_t>(id + 1);
+    }
+    return table;
+}
+
+inline bool same_name(const char *a, std::size_t a_size, const char *b, std::size_t b_size) noexcept {
+    return a_size == b_size && ::strncasecmp(a, b, a_size) == 0;
+}
+}
+
+field_id http::intern_field(const char *name, std::size_t size) noexcept {
+    static const auto table = make_intern_table();
+    auto slot = folded_hash(name, size) % intern_table_size;
+    while (auto id = table[slot]) {
+        const auto &candidate = field_names[id - 1];
+        if (same_name(name, size, candidate.name, candidate.size))
+            return static_cast<field_id>(id - 1);
+        slot = (slot + 1) % intern_table_size;
+    }
+    return field_id::custom;
+}
+
+const char *http::field_name(field_id id) noexcept { return field_names[static_cast<std::size_t>(id)].name; }
+
+std::size_t http::field_name_size(field_id id) noexcept { return field_names[static_cast<std::size_t>(id)].size; }
+
+const header_map::entry *header_map::find(field_id id, const char *name, std::size_t size) const noexcept {
+    if (id != field_id::custom) {
+        auto slot = slots[static_cast<std::size_t>(id)];
+        if (slot != absent)
+            return &at(slot - 1);
+        for (std::size_t i = max_indexed; i < count; ++i)
+            if (at(i).id == id)
+                return &at(i);
+        return nullptr;
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto &e = at(i);
+        if (e.id == field_id::custom && same_name(name, size, e.custom_name.data(), e.custom_name.size()))
+            return &e;
+    }
+    return nullptr;
+}
+
+header_map::entry *header_map::find(field_id id, const char *name, std::size_t size) noexcept {
+    return const_cast<entry *>(static_cast<const header_map *>(this)->find(id, name, size));
+}
+
+header_map::entry &header_map::append(field_id id, const char *name, std::size_t size) {
+    if (count < inline_capacity) {
+        inline_entries[count] = entry{};
+    } else {
+        overflow.emplace_back();
+    }
+    auto &e = at(count++);
+    e.id = id;
+    if (id == field_id::custom)
+        e.custom_name.assign(name, size);
+    else if (likely(count <= max_indexed))
+        slots[static_cast<std::size_t>(id)] = static_cast<std::uint8_t>(count);
+    return e;
+}
+
+const std::string *header_map::get(known_field field) const noexcept {
+    auto e = find(field.id, nullptr, 0);
+    return e ? &e->value : nullptr;
+}
+
+const std::string *header_map::get(const std::string &name) const noexcept {
+    auto e = find(intern_field(name.data(), name.size()), name.data(), name.size());
+    return e ? &e->value : nullptr;
+}
+
+void header_map::set(known_field field, const std::string &value) {
+    auto e = find(field.id, nullptr, 0);
+    (e ? *e : append(field.id, nullptr, 0)).value = value;
+}
+
+void header_map::set(const std::string &name, const std::string &value) {
+    auto id = intern_field(name.data(), name.size());
+    auto e = find(id, name.data(), name.size());
+    (e ? *e : append(id, name.data(), name.size())).value = value;
+}
+
+bool header_map::insert(const std::string &name, const std::string &value) {
+    auto id = intern_field(name.data(), name.size());
+    if (find(id, name.data(), name.size()))
+        return false;
+    append(id, name.data(), name.size()).value = value;
+    return true;
+}
+
+void header_map::clear() noexcept {
+    overflow.clear();
+    slots.fill(absent);
+    count = 0;
+}
+
+bool header_map::operator==(const header_map &other) const noexcept {
+    if (count != other.count)
+        return false;
+    for (const auto &e : *this) {
+        auto match = other.find(e.id, e.custom_name.data(), e.custom_name.size());
+        if (!match || match->value != e.value)
+            return false;
+    }
+    return true;
+}
@@ -0,0 +1,206 @@
+/*
+Copyright (C) 2015 Voinea Constantin Vladimir
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+#ifndef HEADER_MAP_H
+#define HEADER_MAP_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace http {
+/* Every field name we know. field_id, the name table and header::fields are all generated from this list */
+#define VIKING_HEADER_FIELDS(X) \
+    X(Permanent, "Permanent") \
+    X(If_Modified_Since, "If-Modified-Since") \
+    X(Cache_Control, "Cache-Control") \
+    X(Content_Length, "Content-Length") \
+    X(Content_MD5, "Content-MD5") \
+    X(Content_Type, "Content-Type") \
+    X(Date, "Date") \
+    X(Pragma, "Pragma") \
+    X(Upgrade, "Upgrade") \
+    X(Via, "Via") \
+    X(Warning, "Warning") \
+    X(Accept, "Accept") \
+    X(Accept_Charset, "Accept-Charset") \
+    X(Accept_Encoding, "Accept-Encoding") \
+    X(Accept_Language, "Accept-Language") \
+    X(Accept_Datetime, "Accept-Datetime") \
+    X(Authorization, "Authorization") \
+    X(Connection, "Connection") \
+    X(Cookie, "Cookie") \
+    X(Expect, "Expect") \
+    X(From, "From") \
+    X(Host, "Host") \
+    X(If_Match, "If-Match") \
+    X(If_None_Match, "If-None-Match") \
+    X(If_Range, "If-Range") \
+    X(If_Unmodified_Since, "If-Unmodified-Since") \
+    X(Max_Forwards, "Max-Forwards") \
+    X(Origin, "Origin") \
+    X(Proxy_Authorization, "Proxy-Authorization") \
+    X(Range, "Range") \
+    X(Referer, "Referer") \
+    X(TE, "TE") \
+    X(User_Agent, "User-Agent") \
+    X(X_Requested_With, "X-Requested-With") \
+    X(DNT, "DNT") \
+    X(X_Forwarded_For, "X-Forwarded-For") \
+    X(X_Forwarded_Host, "X-Forwarded-Host") \
+    X(X_Forwarded_Proto, "X-Forwarded-Proto") \
+    X(Front_End_Https, "Front-End-Https") \
+    X(X_Http_Method_Override, "X-Http-Method-Override") \
+    X(X_ATT_DeviceId, "X-ATT-DeviceId") \
+    X(X_Wap_Profile, "X-Wap-Profile") \
+    X(Proxy_Connection, "Proxy-Connection") \
+    X(X_UIDH, "X-UIDH") \
+    X(X_Csrf_Token, "X-Csrf-Token") \
+    X(Access_Control_Allow_Origin, "Access-Control-Allow-Origin") \
+    X(Accept_Patch, "Accept-Patch") \
+    X(Accept_Ranges, "Accept-Ranges") \
+    X(Age, "Age") \
+    X(Allow, "Allow") \
+    X(Content_Disposition, "Content-Disposition") \
+    X(Content_Encoding, "Content-Encoding") \
+    X(Content_Language, "Content-Language") \
+    X(Contentw_Location, "Content-Location") \
+    X(Content_Range, "Content-Range") \
+    X(ETag, "ETag") \
+    X(Expires, "Expires") \
+    X(Last_Modified, "Last-Modified") \
+    X(Link, "Link") \
+    X(Location, "Location") \
+    X(P3P, "P3P") \
+    X(Proxy_Authenticate, "Proxy-Authenticate") \
+    X(Public_Key_PinsPerma, "Public-Key-PinsPerma") \
+    X(Retry_After, "Retry-After") \
+    X(Server, "Server") \
+    X(Set_Cookie, "Set-Cookie") \
+    X(Status, "Status") \
+    X(Strict_Transport_Security, "Strict-Transport-Security") \
+    X(Trailer, "Trailer") \
+    X(Transfer_Encoding, "Transfer-Encoding") \
+    X(Vary, "Vary") \
+    X(WWW_Authenticate, "WWW-Authenticate") \
+    X(X_Frame_Options, "X-Frame-Options") \
+    X(X_XSS_Protection, "X-XSS-Protection") \
+    X(Content_Security_Policy, "Content-Security-Policy") \
+    X(X_Content_Security_Policy, "X-Content-Security-Policy") \
+    X(X_WebKit_CSP, "X-WebKit-CSP") \
+    X(X_Content_Type_Options, "X-Content-Type-Options") \
+    X(X_Powered_By, "X-Powered-By") \
+    X(X_Content_Duration, "X-Content-Duration") \
+    X(X_UA_Compatible, "X-UA-Compatible")
+
+/* Every field name listed in header::fields, interned. custom marks names we don't know about */
+#define VIKING_FIELD_ID(id, name) id,
+enum class field_id : std::uint8_t { VIKING_HEADER_FIELDS(VIKING_FIELD_ID) custom };
+#undef VIKING_FIELD_ID
+
+constexpr std::size_t known_field_count = static_cast<std::size_t>(field_id::custom);
+
+struct known_field {
+    field_id id;
+    const char *name;
+    constexpr operator const char *() const noexcept { return name; }
+};
+
+/* Interns a field name, comparing case-insensitively. Returns field_id::custom for unknown names */
+field_id intern_field(const char *name, std::size_t size) noexcept;
+const char *field_name(field_id) noexcept;
+std::size_t field_name_size(field_id) noexcept;
+
+/* Flat storage for the handful of fields a message usually carries. The first inline_capacity
+ * fields live inside the object, the rest spill into a vector. Well-known fields are found
+ * through an index array, custom ones by a case-insensitive scan.
+ */
+class header_map {
+    public:
+    /* Responses carry 7 to 10 fields, so 8 covers most of them. Each entry is 72 bytes, the map 696 */
+    static constexpr std::size_t inline_capacity = 8;
+
+    struct entry {
+        field_id id = field_id::custom;
+        std::string custom_name;
+        std::string value;
+
+        const char *name() const noexcept { return id == field_id::custom ? custom_name.c_str() : field_name(id); }
+        std::size_t name_size() const noexcept {
+            return id == field_id::custom ? custom_name.size() : field_name_size(id);
+        }
+    };
+
+    class const_iterator {
+        const header_map *map;
+        std::size_t index;
+
+        public:
+        const_iterator(const header_map *map, std::size_t index) : map(map), index(index) {}
+        const entry &operator*() const { return map->at(index); }
+        const entry *operator->() const { return &map->at(index); }
+        const_iterator &operator++() {
+            ++index;
+            return *this;
+        }
+        bool operator==(const const_iterator &other) const { return index == other.index; }
+        bool operator!=(const const_iterator &other) const { return index != other.index; }
+    };
+
+    private:
+    /* Slots hold position + 1, so only the first 255 fields are indexed: past that, known ones are also scanned */
+    static constexpr std::uint8_t absent = 0;
+    static constexpr std::size_t max_indexed = UINT8_MAX;
+
+    std::array<entry, inline_capacity> inline_entries;
+    std::vector<entry> overflow;
+    std::array<std::uint8_t, known_field_count> slots{};
+    std::size_t count = 0;
+
+    entry &at(std::size_t i) { return i < inline_capacity ? inline_entries[i] : overflow[i - inline_capacity]; }
+    entry *find(field_id, const char *, std::size_t) noexcept;
+    const entry *find(field_id, const char *, std::size_t) const noexcept;
+    entry &append(field_id, const char *, std::size_t);
+
+    public:
+    header_map() = default;
+    ~header_map() = default;
+
+    const entry &at(std::size_t i) const {
+        return i < inline_capacity ? inline_entries[i] : overflow[i - inline_capacity];
+    }
+    std::size_t size() const noexcept { return count; }
+    bool empty() const noexcept { return count == 0; }
+    const_iterator begin() const noexcept { return {this, 0}; }
+    const_iterator end() const noexcept { return {this, count}; }
+
+    const std::string *get(known_field) const noexcept;
+    const std::string *get(const std::string &) const noexcept;
+
+    /* set() replaces an existing value, insert() keeps it */
+    void set(known_field, const std::string &);
+    void set(const std::string &, const std::string &);
+    bool insert(const std::string &, const std::string &);
+
+    void clear() noexcept;
+    bool operator==(const header_map &) const noexcept;
+};
+}
+
+#endif // HEADER_MAP_H
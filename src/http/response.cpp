@@ -16,6 +16,8 @@ License along with this library; if not, write to the Free Software
 Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 
 */
+#include <http/compression_policy.h>
+#include <http/content_negotiation.h>
 #include <http/header.h>
 #include <http/request.h>
 #include <http/response.h>
@@ -28,6 +30,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include <misc/debug.h>
 #include <misc/storage.h>
 #include <misc/string_util.h>
+#include <misc/thread_pool.h>
 
 #include <algorithm>
 #include <iomanip>
@@ -36,6 +39,10 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include <utility>
 
 using namespace http;
+typedef content_negotiation negotiation;
+typedef content_negotiation::coding coding;
+
+static thread_local bool deferring_compression = false;
 
 status_code response::get_code() const noexcept { return code_; }
 void response::set_code(status_code code) noexcept { code_ = code; }
@@ -47,6 +54,7 @@ const resource &response::get_resource() const { return res; }
 void response::set_resource(const resource &r) noexcept { res = r; }
 
 const std::vector<char> &response::get_text() const noexcept { return text_; }
+std::vector<char> response::release_text() noexcept { return std::move(text_); }
 void response::set_text(const std::string &text) noexcept {
     text_ = {text.cbegin(), text.cend()};
     type_ = type::text;
@@ -59,28 +67,32 @@ void response::set_file(io::unix_file *file) noexcept {
 }
 
 response &response::set(const std::string &field, const std::string &value) noexcept {
-    fields[field] = value;
+    fields.set(field, value);
+    return *this;
+}
+
+response &response::set(known_field field, const std::string &value) noexcept {
+    fields.set(field, value);
     return *this;
 }
 
 using f = http::header::fields;
 
-bool response::get(const std::string &str, std::string &target, bool from_req) const noexcept {
-    if (from_req) {
-        auto it = fields.find(str);
-        if (it != fields.end()) {
-            target = it->second;
-            return true;
-        }
-        return false;
-    } else {
-        auto it = req.m_header.get_fields_c().find(str);
-        if (it != req.m_header.get_fields_c().end()) {
-            target = it->second;
-            return true;
-        }
-        return false;
+template <typename Field>
+static bool get_field(const header_map &fields, const Field &field, std::string &target) noexcept {
+    if (auto value = fields.get(field)) {
+        target = *value;
+        return true;
     }
+    return false;
+}
+
+bool response::get(const std::string &str, std::string &target, bool from_req) const noexcept {
+    return get_field(from_req ? fields : req.m_header.get_fields_c(), str, target);
+}
+
+bool response::get(known_field field, std::string &target, bool from_req) const noexcept {
+    return get_field(from_req ? fields : req.m_header.get_fields_c(), field, target);
 }
 
 request response::get_request() const { return req; }
@@ -89,14 +101,52 @@ void response::set_request(const request &value) { req = value; }
 
 bool response::body_available() const noexcept { return get_type() == type::resource || get_type() == type::text; }
 
+const resource::buffer &response::cached_fields() const noexcept { return cached_fields_; }
+
+resource::buffer response::shared_body() const noexcept {
+    if (get_type() != type::resource)
+        return nullptr;
+    if (compressed == compression_type::deflate)
+        return res.deflated;
+    if (compressed == compression_type::gzip)
+        return res.gzipped;
+    return res.raw;
+}
+
+static const std::vector<char> no_body;
+
+resource::view response::body_bytes() const noexcept {
+    if (compressed == compression_type::deflate)
+        return res.deflated_bytes();
+    if (compressed == compression_type::gzip)
+        return res.gzipped_bytes();
+    return res.raw_bytes();
+}
+
+resource::memfd response::sealed_body() noexcept {
+    auto &memfd = compressed == compression_type::deflate
+                      ? res.deflated_memfd
+                      : compressed == compression_type::gzip ? res.gzipped_memfd : res.raw_memfd;
+    if (memfd)
+        return memfd;
+    auto &body = compressed == compression_type::deflate
+                     ? res.deflated
+                     : compressed == compression_type::gzip ? res.gzipped : res.raw;
+    if (!body)
+        return nullptr;
+    memfd = io::sealed_memfd::create(res.path().filename().string(), *body);
+    /* The mapping reads the memfd's own pages, the vector would only be a second copy */
+    if (memfd && memfd->data())
+        body = nullptr;
+    return memfd;
+}
+
 const std::vector<char> &response::body() const {
     switch (get_type()) {
     case type::resource:
-        if (compressed == compression_type::deflate)
-            return res.deflated;
-        if (compressed == compression_type::gzip)
-            return res.gzipped;
-        return res.raw;
+        if (auto buffer = shared_body())
+            return *buffer;
+        return no_body;
         break;
     case type::text:
         return text_;
@@ -109,57 +159,154 @@ const std::vector<char> &response::body() const {
 
 std::size_t response::content_len() const noexcept {
     if (get_type() == type::file)
-        return file_->size;
+        return file_->length();
+    if (get_type() == type::resource)
+        return body_bytes().size;
     return body().size();
 }
 
 bool response::get_keep_alive() const noexcept {
-    auto it = fields.find(f::Connection);
-    return it != fields.end() ? uppercase(it->second) == "KEEP-ALIVE" : true;
-}
-
-void response::try_to_compress() noexcept {
-    if (body_available() && compressed == compression_type::none) {
-        switch (get_type()) {
-        case type::resource:
-            if (util::can_compress(req, "deflate")) {
-                if (!res.deflated.size())
-                    res.deflated = compression::deflate(res.raw);
-                set(f::Content_Encoding, "deflate");
-                compressed = compression_type::deflate;
-            } else if (util::can_compress(req, "gzip")) {
-                if (!res.gzipped.size())
-                    res.gzipped = compression::gzip(res.raw);
-                set(f::Content_Encoding, "gzip");
-                compressed = compression_type::gzip;
-            }
+    auto value = fields.get(f::Connection);
+    return value ? uppercase(*value) == "KEEP-ALIVE" : true;
+}
+
+void response::try_to_compress(const std::string &mime_type) noexcept {
+    deferred_level_ = -1;
+    const auto raw = res.raw_bytes();
+    if (!body_available() || compressed != compression_type::none || (get_type() == type::resource && !raw))
+        return;
+    auto policy = get_type() == type::resource ? compression_policy::decide(mime_type, raw.data, raw.size)
+                                               : compression_policy::decide(mime_type, text_);
+    if (!policy.compress)
+        return;
+    set(f::Vary, "Accept-Encoding");
+    switch (get_type()) {
+    case type::resource:
+        /* Cached variants are kept for gzip and deflate only */
+        switch (negotiation::choose(req, {coding::gzip, coding::deflate})) {
+        case coding::gzip:
+            if (!res.gzipped_bytes())
+                res.gzipped = std::make_shared<const std::vector<char>>(
+                    compression::gzip(raw.data, raw.size, policy.level));
+            set(f::Content_Encoding, "gzip");
+            compressed = compression_type::gzip;
             break;
-        case type::text:
-            if (util::can_compress(req, "deflate")) {
-                text_ = compression::deflate(text_);
-                set(f::Content_Encoding, "deflate");
-                compressed = compression_type::deflate;
-            } else if (util::can_compress(req, "gzip")) {
-                text_ = compression::gzip(text_);
-                set(f::Content_Encoding, "gzip");
-                compressed = compression_type::gzip;
-            }
+        case coding::deflate:
+            if (!res.deflated_bytes())
+                res.deflated = std::make_shared<const std::vector<char>>(
+                    compression::deflate(raw.data, raw.size, policy.level));
+            set(f::Content_Encoding, "deflate");
+            compressed = compression_type::deflate;
             break;
         default:
             break;
         }
+        break;
+    case type::text:
+        if (deferring_compression && storage::config().compression_threads &&
+            text_.size() >= storage::config().compression_offload_min_size)
+            deferred_level_ = policy.level;
+        else
+            compress_text(policy.level);
+        break;
+    default:
+        break;
+    }
+}
+
+/* Generated bodies are compressed once, so the cheaper and denser codings are worth offering first */
+void response::compress_text(int level, thread_pool *blocks) noexcept {
+    const auto &config = storage::config();
+    coding offered[4];
+    std::size_t count = 0;
+    for (auto c : {coding::zstd, coding::br, coding::gzip, coding::deflate})
+        if (negotiation::can_encode(c))
+            offered[count++] = c;
+    const auto chosen = negotiation::choose(req, offered, count);
+    /* The body is only replaced once a coding succeeded, a failure leaves it as it was and uncompressed */
+    try {
+        switch (chosen) {
+#ifdef VIKING_ZSTD
+        case coding::zstd:
+            text_ = compression::zstd(text_, config.compression_level_zstd);
+            compressed = compression_type::zstd;
+            break;
+#endif
+#ifdef VIKING_BROTLI
+        case coding::br:
+            text_ = compression::brotli(text_, config.compression_level_brotli);
+            compressed = compression_type::br;
+            break;
+#endif
+        case coding::gzip:
+            text_ = blocks ? compression::parallel(*blocks, compression::format::gzip, text_.data(), text_.size(),
+                                                   level, config.compression_block_size)
+                           : compression::gzip(text_, level);
+            compressed = compression_type::gzip;
+            break;
+        case coding::deflate:
+            text_ = blocks ? compression::parallel(*blocks, compression::format::deflate, text_.data(), text_.size(),
+                                                   level, config.compression_block_size)
+                           : compression::deflate(text_, level);
+            compressed = compression_type::deflate;
+            break;
+        default:
+            return;
+        }
+    } catch (...) {
+        return;
     }
+    set(f::Content_Encoding, negotiation::name(chosen));
 }
 
-void response::init() {
+void response::defer_compression(bool defer) noexcept { deferring_compression = defer; }
+
+bool response::compression_pending() const noexcept { return deferred_level_ >= 0; }
+
+void response::finish_compression(thread_pool &blocks) noexcept {
+    if (!compression_pending())
+        return;
+    compress_text(deferred_level_, &blocks);
+    deferred_level_ = -1;
+    set(f::Content_Length, std::to_string(content_len()));
+}
+
+static std::string entity_tag(const resource &res, response::compression_type compressed) {
+    std::ostringstream tag;
+    tag << '"' << std::hex << fs::file_time_type::clock::to_time_t(res.last_write()) << '-' << res.raw_bytes().size;
+    if (compressed == response::compression_type::deflate)
+        tag << "-deflate";
+    else if (compressed == response::compression_type::gzip)
+        tag << "-gzip";
+    tag << '"';
+    return tag.str();
+}
+
+void response::init(const std::string &content_type) {
+    cached_fields_ = nullptr;
     if (storage::config().enable_compression)
-        try_to_compress();
+        try_to_compress(content_type);
     version = {1, 1};
-    fields.reserve(7);
-    set(f::Date, date::now().to_string());
+    set_static_fields(content_type);
+    set_dynamic_fields();
+}
+
+/* Fields that only depend on the body and its variant */
+void response::set_static_fields(const std::string &content_type) {
     set(f::Access_Control_Allow_Origin, "*");
-    set(f::Content_Type, "text/plain; charset=utf-8");
+    set(f::Content_Type, content_type);
     set(f::Transfer_Encoding, "binary");
+    if (get_type() == type::resource && res.raw_bytes()) {
+        set(f::ETag, entity_tag(res, compressed));
+        set(f::Last_Modified, date(fs::file_time_type::clock::to_time_t(res.last_write())).to_string());
+    }
+    if (body_available())
+        set(f::Content_Length, std::to_string(content_len()));
+}
+
+/* Fields that depend on the time or on the request */
+void response::set_dynamic_fields() {
+    set(f::Date, date::now_string());
 
     std::string req_conn_status;
     if (get(f::Connection, req_conn_status, true))
@@ -170,9 +317,48 @@ void response::init() {
     std::string req_cache_control;
     if (get(f::Cache_Control, req_cache_control, true) && req_cache_control.find("no-cache") == std::string::npos)
         set(f::Cache_Control, "max-age=" + std::to_string(storage::config().default_max_age));
+}
 
-    if (body_available())
-        set(f::Content_Length, std::to_string(content_len()));
+/* The rendered fields of the variant this request gets, null when they still have to be rendered */
+resource::buffer response::select_cached_fields() noexcept {
+    if (!res.raw_fields && !res.deflated_fields && !res.gzipped_fields)
+        return nullptr;
+    if (storage::config().enable_compression && res.compressible) {
+        switch (negotiation::choose(req, {coding::gzip, coding::deflate})) {
+        case coding::gzip:
+            if (res.gzipped_fields)
+                compressed = compression_type::gzip;
+            return res.gzipped_fields;
+        case coding::deflate:
+            if (res.deflated_fields)
+                compressed = compression_type::deflate;
+            return res.deflated_fields;
+        default:
+            break;
+        }
+    }
+    return res.raw_fields;
+}
+
+/* Moves the static fields out of the map into a buffer the resource keeps for its variant */
+resource::buffer response::render_cached_fields() {
+    std::vector<char> rendered;
+    for (const auto &field : fields) {
+        rendered.insert(rendered.end(), field.name(), field.name() + field.name_size());
+        rendered.insert(rendered.end(), {':', ' '});
+        rendered.insert(rendered.end(), field.value.begin(), field.value.end());
+        rendered.insert(rendered.end(), {'\r', '\n'});
+    }
+    auto buffer = std::make_shared<const std::vector<char>>(std::move(rendered));
+    res.compressible = fields.get(f::Vary) != nullptr;
+    if (compressed == compression_type::deflate)
+        res.deflated_fields = buffer;
+    else if (compressed == compression_type::gzip)
+        res.gzipped_fields = buffer;
+    else
+        res.raw_fields = buffer;
+    fields.clear();
+    return buffer;
 }
 
 response::response(request r) : req(r), code_(status_code::OK), compressed(compression_type::none) {
@@ -181,12 +367,16 @@ response::response(request r) : req(r), code_(status_code::OK), compressed(compr
 }
 
 response::response(request r, io::unix_file *file)
+    : response(r, file, file ? http::util::get_mimetype(file->path) : std::string{}) {}
+
+response::response(request r, io::unix_file *file, const std::string &content_type)
     : req(r), code_(status_code::OK), compressed(compression_type::none), file_(file) {
     type_ = type::file;
-    init();
     if (file) {
-        set(f::Content_Type, http::util::get_mimetype(file->path));
-        set(f::Content_Length, std::to_string(file->size));
+        init(content_type);
+        set(f::Content_Length, std::to_string(file->length()));
+    } else {
+        init();
     }
 }
 
@@ -204,8 +394,48 @@ response::response(request r, const std::string &text)
 response::response(request r, const resource &resource)
     : req(r), code_(status_code::OK), res(resource), compressed(compression_type::none) {
     type_ = type::resource;
-    init();
-    set(f::Content_Type, http::util::get_mimetype(resource.path()));
+    init(http::util::get_mimetype(resource.path()));
+}
+
+response::response(request r, const resource &resource, from_cache_tag)
+    : req(r), code_(status_code::OK), res(resource), compressed(compression_type::none) {
+    type_ = type::resource;
+    version = {1, 1};
+    if (!(cached_fields_ = select_cached_fields())) {
+        auto mime_type = http::util::get_mimetype(res.path());
+        if (storage::config().enable_compression)
+            try_to_compress(mime_type);
+        set_static_fields(mime_type);
+        cached_fields_ = render_cached_fields();
+    }
+    set_dynamic_fields();
+}
+
+response response::from_cache(request r, const resource &resource) { return {r, resource, from_cache_tag{}}; }
+
+bool response::unchanged_for(const request &r, const std::string &etag, std::time_t last_write) noexcept {
+    const auto &fields = r.m_header.get_fields_c();
+    /* If-None-Match wins when both are sent */
+    if (auto tags = fields.get(f::If_None_Match))
+        return *tags == "*" || tags->find(etag) != std::string::npos;
+    std::time_t since = 0;
+    auto modified_since = fields.get(f::If_Modified_Since);
+    return modified_since && date::parse(*modified_since, since) && last_write <= since;
+}
+
+bool response::unchanged() const noexcept {
+    if (get_type() != type::resource || !res.raw_bytes())
+        return false;
+    return unchanged_for(req, entity_tag(res, compressed), fs::file_time_type::clock::to_time_t(res.last_write()));
+}
+
+response response::not_modified() const {
+    response result{req, status_code::NotModified};
+    result.set(f::ETag, entity_tag(res, compressed));
+    result.set(f::Last_Modified, date(fs::file_time_type::clock::to_time_t(res.last_write())).to_string());
+    if (compressed != compression_type::none || res.compressible)
+        result.set(f::Vary, "Accept-Encoding");
+    return result;
 }
 
 response &response::operator=(const std::string &str) {
@@ -218,7 +448,7 @@ response &response::operator=(const std::string &str) {
 response &response::operator=(const resource &r) {
     type_ = type::resource;
     res = r;
-    init();
+    init(http::util::get_mimetype(r.path()));
     return *this;
 }
 
@@ -26,23 +26,35 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include <io/buffers/unix_file.h>
 #include <misc/resource.h>
 
+#include <ctime>
 #include <future>
 #include <string>
-#include <unordered_map>
+
+class thread_pool;
 
 namespace http {
 class response {
     public:
     struct body_unavailable {};
     enum class type { resource, file, text };
-    enum class compression_type { deflate, gzip, none };
+    enum class compression_type { deflate, gzip, br, zstd, none };
     response() = delete;
     response(request);
     response(request, io::unix_file *);
+    /* For callers that already know the file's type */
+    response(request, io::unix_file *, const std::string &content_type);
     response(request, status_code);
     response(request, const std::string &);
     response(request, http::status_code, const std::string &);
     response(request, const resource &);
+    /* A cache hit, reusing the header lines the resource keeps for the chosen variant. The dispatcher
+     * serializes these responses as they are, adding fields to them afterwards is not supported.
+     */
+    static response from_cache(request, const resource &);
+    /* Whether the client already has the body with these validators: its If-None-Match lists the tag or, when it
+     * sends none, nothing changed since its If-Modified-Since
+     */
+    static bool unchanged_for(const request &, const std::string &etag, std::time_t last_write) noexcept;
     response &operator=(const std::string &);
     response &operator=(const resource &);
     response &operator=(status_code);
@@ -61,22 +73,46 @@ class response {
 
     const std::vector<char> &get_text() const noexcept;
     void set_text(const std::string &) noexcept;
+    /* Moves the generated body out so it can be sent without a copy. Serialize the header first */
+    std::vector<char> release_text() noexcept;
 
     const io::unix_file *get_file() const noexcept;
     void set_file(io::unix_file *file) noexcept;
 
     bool get_keep_alive() const noexcept;
     response &set(const std::string &field, const std::string &value) noexcept;
+    response &set(known_field field, const std::string &value) noexcept;
     bool get(const std::string &, std::string &, bool = false) const noexcept;
+    bool get(known_field, std::string &, bool = false) const noexcept;
 
-    std::unordered_map<std::string, std::string> fields;
+    header_map fields;
     http_version version;
 
     request get_request() const;
     void set_request(const request &value);
 
+    /* While set on a thread, large generated bodies built there are left uncompressed until finish_compression()
+     * is called, so that the thread doesn't have to wait for them
+     */
+    static void defer_compression(bool) noexcept;
+    bool compression_pending() const noexcept;
+    /* Compresses a deferred body, gzip and deflate ones in blocks spread over the pool */
+    void finish_compression(thread_pool &) noexcept;
+
     bool body_available() const noexcept;
     const std::vector<char> &body() const;
+    /* The cached body the response refers to, null when it owns its body */
+    resource::buffer shared_body() const noexcept;
+    /* Sealed memfd copy of the cached body, created on first use and kept by the resource. The resource then lets go
+     * of the body's vector, shared_body() is null from there on
+     */
+    resource::memfd sealed_body() noexcept;
+    /* For a resource, whether the request's validators match the variant it gets */
+    bool unchanged() const noexcept;
+    /* The bodiless 304 for the same resource and variant, carrying its validators */
+    response not_modified() const;
+    /* Header lines rendered ahead of time, written out before the fields */
+    const resource::buffer &cached_fields() const noexcept;
 
     private:
     request req;
@@ -85,9 +121,20 @@ class response {
     resource res;
     std::vector<char> text_;
     compression_type compressed;
+    /* The level a deferred body is to be compressed with, -1 when there is none */
+    int deferred_level_ = -1;
     const io::unix_file *file_ = nullptr;
-    void init();
-    void try_to_compress() noexcept;
+    resource::buffer cached_fields_;
+    struct from_cache_tag {};
+    response(request, const resource &, from_cache_tag);
+    void init(const std::string &content_type = "text/plain; charset=utf-8");
+    void set_static_fields(const std::string &content_type);
+    void set_dynamic_fields();
+    void try_to_compress(const std::string &mime_type) noexcept;
+    void compress_text(int level, thread_pool *blocks = nullptr) noexcept;
+    resource::buffer select_cached_fields() noexcept;
+    resource::view body_bytes() const noexcept;
+    resource::buffer render_cached_fields();
 };
 };
 
@@ -17,57 +17,96 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 
 */
 #include <http/response_serializer.h>
-#include <iterator>
+#include <io/buffers/buffer_pool.h>
 #include <misc/common.h>
-#include <misc/date.h>
-#include <misc/string_util.h>
-#include <sstream>
 #include <string.h>
-#include <unistd.h>
 
 static constexpr auto crlf = "\r\n";
 static constexpr auto crlfcrlf = "\r\n\r\n";
+static constexpr std::size_t crlf_len = 2;
+static constexpr std::size_t crlfcrlf_len = 4;
 
-std::vector<char> response_serializer::make_header(const http::response &r) noexcept {
-    std::string response;
-    response.reserve(256);
-    response.append("HTTP/")
-        .append(std::to_string(r.version.major))
-        .append(".")
-        .append(std::to_string(r.version.minor));
-    response.append(" ").append(std::to_string(r.get_code())).append(" ");
-    response.append(http::status_codes.at(r.get_code())).append(crlf);
-    for (const auto &pair : r.fields)
-        response.append(pair.first).append(": ").append(pair.second).append(crlf);
-    response.append(crlf);
-    return {response.begin(), response.end()};
+static inline void append(std::vector<char> &buffer, const char *str, std::size_t len) noexcept {
+    buffer.insert(buffer.end(), str, str + len);
+}
+
+static inline void append(std::vector<char> &buffer, const std::string &str) noexcept {
+    append(buffer, str.data(), str.size());
+}
+
+static inline void append_number(std::vector<char> &buffer, std::uint32_t number) noexcept {
+    char digits[10];
+    auto begin = digits + sizeof(digits), end = begin;
+    do {
+        *--begin = '0' + number % 10;
+        number /= 10;
+    } while (number);
+    append(buffer, begin, end - begin);
+}
+
+static inline http::status_line status_line_of(const http::response &r) noexcept {
+    if (r.version.major == 1 && r.version.minor == 1)
+        return http::serialized_status_line(r.get_code());
+    return {nullptr, 0};
 }
 
-std::vector<char> response_serializer::make_body(const http::response &response) noexcept {
-    return response.body();
-    switch (response.get_type()) {
-    case http::response::type::resource:
-        return response.body();
-    case http::response::type::text:
-        return {response.get_text().begin(), response.get_text().end()};
-    default:
-        return {};
+std::size_t response_serializer::header_size(const http::response &r) noexcept {
+    auto line = status_line_of(r);
+    /* "HTTP/x.y NNN " plus generous room for the version numbers */
+    std::size_t size = line.text ? line.size : 16 + http::status_codes.at(r.get_code()).size() + crlf_len;
+    if (const auto &cached = r.cached_fields())
+        size += cached->size();
+    for (const auto &field : r.fields)
+        size += field.name_size() + 2 + field.value.size() + crlf_len;
+    return size + crlf_len;
+}
+
+void response_serializer::append_header(std::vector<char> &buffer, const http::response &r) noexcept {
+    auto line = status_line_of(r);
+    if (likely(line.text != nullptr)) {
+        append(buffer, line.text, line.size);
+    } else {
+        append(buffer, "HTTP/", 5);
+        append_number(buffer, r.version.major);
+        buffer.push_back('.');
+        append_number(buffer, r.version.minor);
+        buffer.push_back(' ');
+        append_number(buffer, r.get_code());
+        buffer.push_back(' ');
+        append(buffer, http::status_codes.at(r.get_code()));
+        append(buffer, crlf, crlf_len);
+    }
+    if (const auto &cached = r.cached_fields())
+        append(buffer, cached->data(), cached->size());
+    for (const auto &field : r.fields) {
+        append(buffer, field.name(), field.name_size());
+        append(buffer, ": ", 2);
+        append(buffer, field.value);
+        append(buffer, crlf, crlf_len);
     }
+    append(buffer, crlf, crlf_len);
+}
+
+std::vector<char> response_serializer::make_header(const http::response &r) noexcept {
+    auto buffer = io::buffer_pool::aquire(header_size(r));
+    append_header(buffer, r);
+    return buffer;
 }
 
 std::vector<char> response_serializer::make_ending(const http::response &) noexcept {
-    return std::vector<char>(crlfcrlf, crlfcrlf + strlen(crlfcrlf));
+    auto buffer = io::buffer_pool::aquire(crlfcrlf_len);
+    append(buffer, crlfcrlf, crlfcrlf_len);
+    return buffer;
 }
 
 std::vector<char> response_serializer::operator()(const http::response &response) noexcept {
-    auto header = make_header(response);
-    auto body = make_body(response);
-    auto ending = make_ending(response);
+    static const std::vector<char> no_body;
+    const auto &body = response.body_available() ? response.body() : no_body;
 
-    std::vector<char> buffer;
-    buffer.reserve(getpagesize());
-    buffer.insert(buffer.end(), std::make_move_iterator(header.begin()), std::make_move_iterator(header.end()));
-    buffer.insert(buffer.end(), std::make_move_iterator(body.begin()), std::make_move_iterator(body.end()));
-    buffer.insert(buffer.end(), std::make_move_iterator(ending.begin()), std::make_move_iterator(ending.end()));
+    /* The whole response is laid out once, in a single buffer sized up front */
+    auto buffer = io::buffer_pool::aquire(header_size(response) + body.size() + crlfcrlf_len);
+    append_header(buffer, response);
+    buffer.insert(buffer.end(), body.begin(), body.end());
+    append(buffer, crlfcrlf, crlfcrlf_len);
     return buffer;
 }
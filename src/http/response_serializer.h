@@ -23,12 +23,14 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include <http/response.h>
 
 class response_serializer {
+    std::size_t header_size(const http::response &response) noexcept;
+    void append_header(std::vector<char> &buffer, const http::response &response) noexcept;
+
     public:
     response_serializer() = default;
     virtual ~response_serializer() = default;
 
     std::vector<char> make_header(const http::response &response) noexcept;
-    std::vector<char> make_body(const http::response &response) noexcept;
     std::vector<char> make_ending(const http::response &response) noexcept;
     std::vector<char> operator()(const http::response &response) noexcept;
 };
@@ -16,6 +16,9 @@ License along with this library; if not, write to the Free Software
 Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 
 */
+#include <cache/path_cache.h>
+#include <http/content_negotiation.h>
+#include <http/content_sniffer.h>
 #include <http/util.h>
 #include <inl/mime_types.h>
 #include <io/filesystem.h>
@@ -23,19 +26,6 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include <misc/storage.h>
 using namespace http;
 
-static std::string exec(const std::string &cmd) {
-    std::shared_ptr<FILE> pipe(popen(cmd.c_str(), "r"), pclose);
-    if (!pipe)
-        return "";
-    char buffer[128];
-    std::string result = "";
-    while (!feof(pipe.get())) {
-        if (fgets(buffer, 128, pipe.get()) != NULL)
-            result += buffer;
-    }
-    return result;
-}
-
 bool util::is_passable(const http::request &request) noexcept {
     switch (request.method) {
     case http::method::Get:
@@ -55,17 +45,13 @@ bool util::is_passable(const http::request &request) noexcept {
 }
 
 bool util::is_disk_resource(const request &request) noexcept {
-    fs::path full_path = storage::config().root_path + request.url;
-    if (fs::exists(full_path))
-        return true;
-    return false;
+    return static_cast<bool>(cache::path_cache::resolve(request.url));
 }
 
 bool util::is_complete(const request &request) noexcept {
     if (can_have_body(request.method)) {
-        auto cl_it = request.m_header.get_fields_c().find(http::header::fields::Content_Length);
-        if (cl_it != request.m_header.get_fields_c().end()) {
-            auto content_length = static_cast<std::size_t>(std::atoi(cl_it->second.c_str()));
+        if (auto value = request.m_header.get_fields_c().get(http::header::fields::Content_Length)) {
+            auto content_length = static_cast<std::size_t>(std::atoi(value->c_str()));
             if (request.body.size() < content_length)
                 return false;
         }
@@ -74,14 +60,9 @@ bool util::is_complete(const request &request) noexcept {
     return true;
 }
 
-static inline const std::string get_content_enc_text(const request &r) noexcept {
-    auto it = r.m_header.get_fields_c().find(http::header::fields::Accept_Encoding);
-    return it != r.m_header.get_fields_c().end() ? it->second : "";
-}
-
 bool util::can_compress(const request &r, const std::string &compression_type) noexcept {
-    auto str = get_content_enc_text(r);
-    return str.find(compression_type) != std::string::npos;
+    const auto coding = content_negotiation::from_name(compression_type);
+    return coding != content_negotiation::coding::identity && content_negotiation::accepts(r, coding);
 }
 
 bool util::can_have_body(method method) noexcept {
@@ -97,22 +78,11 @@ bool util::can_have_body(method method) noexcept {
     }
 }
 
-static std::string shell_get_mimetype(fs::path p) noexcept {
-    std::string cmd = "file --mime-type ";
-    cmd.append(p);
-    auto output = exec(cmd);
-    while (output.size() && std::isspace(output.back()))
-        output = output.substr(0, output.size() - 1);
-    auto c = output.find_first_of(':');
-    if (c != std::string::npos && output.size() > ++c)
-        return output.substr(c + 1);
-    return "";
-}
-
 std::string util::get_mimetype(fs::path p) noexcept {
     auto ext = io::get_extension(p);
-    if (ext.length())
-        return mime_types[ext];
-    else
-        return shell_get_mimetype(p);
+    if (ext.length()) {
+        auto type = mime_types::find(ext);
+        return type ? type : "";
+    } else
+        return content_sniffer::sniff_file(p);
 }
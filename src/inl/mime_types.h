@@ -16,988 +16,1299 @@ License along with this library; if not, write to the Free Software
 Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 
 */
+#ifndef MIME_TYPES_H
+#define MIME_TYPES_H
+
+#include <cstddef>
+#include <cstdint>
 #include <string>
-#include <unordered_map>
 
-static std::unordered_map<std::string, std::string> mime_types{
-    {"scm", "application/vnd.lotus-screencam"},
-    {"mny", "application/x-msmoney"},
-    {"dist", "application/octet-stream"},
-    {"gv", "text/vnd.graphviz"},
-    {"roa", "application/rpki-roa"},
-    {"cdf", "application/x-netcdf"},
-    {"edm", "application/vnd.novadigm.edm"},
-    {"otp", "application/vnd.oasis.opendocument.presentation-template"},
-    {"mp4", "video/mp4"},
-    {"woff", "application/x-font-woff"},
-    {"mp3", "audio/mpeg"},
-    {"edx", "application/vnd.novadigm.edx"},
-    {"scq", "application/scvp-cv-request"},
-    {"scs", "application/scvp-cv-response"},
-    {"osf", "application/vnd.yamaha.openscoreformat"},
-    {"wmz", "application/x-msmetafile"},
-    {"ots", "application/vnd.oasis.opendocument.spreadsheet-template"},
-    {"zmm", "application/vnd.handheld-entertainment+xml"},
-    {"ott", "application/vnd.oasis.opendocument.text-template"},
-    {"tr", "text/troff"},
-    {"wmv", "video/x-ms-wmv"},
-    {"vcard", "text/vcard"},
-    {"mwf", "application/vnd.mfer"},
-    {"mpkg", "application/vnd.apple.installer+xml"},
-    {"fh5", "image/x-freehand"},
-    {"fh4", "image/x-freehand"},
-    {"wma", "audio/x-ms-wma"},
-    {"wmf", "application/x-msmetafile"},
-    {"wmd", "application/x-ms-wmd"},
-    {"vxml", "application/voicexml+xml"},
-    {"mpe", "video/mpeg"},
-    {"g3", "image/g3fax"},
-    {"mpc", "application/vnd.mophun.certificate"},
-    {"lrf", "application/octet-stream"},
-    {"mpn", "application/vnd.mophun.application"},
-    {"mpm", "application/vnd.blueice.multipass"},
-    {"lrm", "application/vnd.ms-lrm"},
-    {"rl", "application/resource-lists+xml"},
-    {"mpt", "application/vnd.ms-project"},
-    {"jisp", "application/vnd.jisp"},
-    {"smf", "application/vnd.stardivision.math"},
-    {"mpy", "application/vnd.ibm.minipay"},
-    {"cml", "chemical/x-cml"},
-    {"trm", "application/x-msterminal"},
-    {"tra", "application/vnd.trueapp"},
-    {"eva", "application/x-eva"},
-    {"hbci", "application/vnd.hbci"},
-    {"f", "text/x-fortran"},
-    {"cmc", "application/vnd.cosmocaller"},
-    {"dll", "application/x-msdownload"},
-    {"fhc", "image/x-freehand"},
-    {"thmx", "application/vnd.ms-officetheme"},
-    {"pbd", "application/vnd.powerbuilder6"},
-    {"aas", "application/x-authorware-seg"},
-    {"gqf", "application/vnd.grafeq"},
-    {"pbm", "image/x-portable-bitmap"},
-    {"mp2", "audio/mpeg"},
-    {"tmo", "application/vnd.tmobile-livetv"},
-    {"kpxx", "application/vnd.ds-keypoint"},
-    {"dir", "application/x-director"},
-    {"distz", "application/octet-stream"},
-    {"tei", "application/tei+xml"},
-    {"mcurl", "text/vnd.curl.mcurl"},
-    {"odp", "application/vnd.oasis.opendocument.presentation"},
-    {"htm", "text/html"},
-    {"ods", "application/vnd.oasis.opendocument.spreadsheet"},
-    {"uvvz", "application/vnd.dece.zip"},
-    {"tex", "application/x-tex"},
-    {"odi", "application/vnd.oasis.opendocument.image"},
-    {"odm", "application/vnd.oasis.opendocument.text-master"},
-    {"pml", "application/vnd.ctc-posml"},
-    {"oda", "application/oda"},
-    {"odb", "application/vnd.oasis.opendocument.database"},
-    {"odc", "application/vnd.oasis.opendocument.chart"},
-    {"cfs", "application/x-cfs-compressed"},
-    {"odf", "application/vnd.oasis.opendocument.formula"},
-    {"odg", "application/vnd.oasis.opendocument.graphics"},
-    {"bdf", "application/x-font-bdf"},
-    {"sub", "text/vnd.dvb.subtitle"},
-    {"xop", "application/xop+xml"},
-    {"bdm", "application/vnd.syncml.dm+wbxml"},
-    {"rtx", "text/richtext"},
-    {"dcurl", "text/vnd.curl.dcurl"},
-    {"ms", "text/troff"},
-    {"sus", "application/vnd.sus-calendar"},
-    {"u32", "application/x-authorware-bin"},
-    {"abw", "application/x-abiword"},
-    {"mng", "video/x-mng"},
-    {"ggt", "application/vnd.geogebra.tool"},
-    {"asx", "video/x-ms-asf"},
-    {"install", "application/x-install-instructions"},
-    {"cxx", "text/x-c"},
-    {"sfd-hdstx", "application/vnd.hydrostatix.sof-data"},
-    {"xspf", "application/xspf+xml"},
-    {"les", "application/vnd.hhe.lesson-player"},
-    {"z8", "application/x-zmachine"},
-    {"rlc", "image/vnd.fujixerox.edmics-rlc"},
-    {"ggb", "application/vnd.geogebra.file"},
-    {"z4", "application/x-zmachine"},
-    {"z5", "application/x-zmachine"},
-    {"z6", "application/x-zmachine"},
-    {"z7", "application/x-zmachine"},
-    {"pclxl", "application/vnd.hp-pclxl"},
-    {"teacher", "application/vnd.smart.teacher"},
-    {"z2", "application/x-zmachine"},
-    {"z3", "application/x-zmachine"},
-    {"box", "application/vnd.previewsystems.box"},
-    {"g2w", "application/vnd.geoplan"},
-    {"wdb", "application/vnd.ms-works"},
-    {"onepkg", "application/onenote"},
-    {"ahead", "application/vnd.ahead.space"},
-    {"m3u", "audio/x-mpegurl"},
-    {"appcache", "text/cache-manifest"},
-    {"rdz", "application/vnd.data-vision.rdz"},
-    {"wdp", "image/vnd.ms-photo"},
-    {"rdf", "application/rdf+xml"},
-    {"jpgm", "video/jpm"},
-    {"dra", "audio/vnd.dra"},
-    {"maker", "application/vnd.framemaker"},
-    {"m3a", "audio/mpeg"},
-    {"fbs", "image/vnd.fastbidsheet"},
-    {"apr", "application/vnd.lotus-approach"},
-    {"txf", "application/vnd.mobius.txf"},
-    {"zir", "application/vnd.zul"},
-    {"txd", "application/vnd.genomatix.tuxedo"},
-    {"sgi", "image/sgi"},
-    {"apk", "application/vnd.android.package-archive"},
-    {"obj", "application/x-tgif"},
-    {"sgm", "text/sgml"},
-    {"sgl", "application/vnd.stardivision.writer-global"},
-    {"mmd", "application/vnd.chipnuts.karaoke-mmd"},
-    {"txt", "text/plain"},
-    {"wbmp", "image/vnd.wap.wbmp"},
-    {"wsdl", "application/wsdl+xml"},
-    {"tcap", "application/vnd.3gpp2.tcap"},
-    {"c4u", "application/vnd.clonk.c4group"},
-    {"dna", "application/vnd.dna"},
-    {"twd", "application/vnd.simtech-mindmapper"},
-    {"lwp", "application/vnd.lotus-wordpro"},
-    {"chm", "application/vnd.ms-htmlhelp"},
-    {"smv", "video/x-smv"},
-    {"c4d", "application/vnd.clonk.c4group"},
-    {"xfdf", "application/vnd.adobe.xfdf"},
-    {"c4f", "application/vnd.clonk.c4group"},
-    {"c4g", "application/vnd.clonk.c4group"},
-    {"rpss", "application/vnd.nokia.radio-presets"},
-    {"msi", "application/x-msdownload"},
-    {"msh", "model/mesh"},
-    {"setreg", "application/set-registration-initiation"},
-    {"msf", "application/vnd.epson.msf"},
-    {"pfa", "application/x-font-type1"},
-    {"x32", "application/x-authorware-bin"},
-    {"wvx", "video/x-ms-wvx"},
-    {"pfb", "application/x-font-type1"},
-    {"xaml", "application/xaml+xml"},
-    {"wml", "text/vnd.wap.wml"},
-    {"pfm", "application/x-font-type1"},
-    {"fxpl", "application/vnd.adobe.fxp"},
-    {"ris", "application/x-research-info-systems"},
-    {"t3", "application/x-t3vm-image"},
-    {"lasxml", "application/vnd.las.las+xml"},
-    {"pfr", "application/font-tdpfr"},
-    {"jpg", "image/jpeg"},
-    {"flac", "audio/x-flac"},
-    {"wbxml", "application/vnd.wap.wbxml"},
-    {"pfx", "application/x-pkcs12"},
-    {"fh7", "image/x-freehand"},
-    {"me", "text/troff"},
-    {"flx", "text/vnd.fmi.flexstor"},
-    {"ulx", "application/x-glulx"},
-    {"ma", "application/mathematica"},
-    {"mb", "application/mathematica"},
-    {"car", "application/vnd.curl.car"},
-    {"der", "application/x-x509-ca-cert"},
-    {"cap", "application/vnd.tcpdump.pcap"},
-    {"flw", "application/vnd.kde.kivio"},
-    {"cat", "application/vnd.ms-pki.seccat"},
-    {"fli", "video/x-fli"},
-    {"flo", "application/vnd.micrografx.flo"},
-    {"xht", "application/xhtml+xml"},
-    {"cab", "application/vnd.ms-cab-compressed"},
-    {"deb", "application/x-debian-package"},
-    {"gqs", "application/vnd.grafeq"},
-    {"caf", "audio/x-caf"},
-    {"def", "text/plain"},
-    {"avi", "video/x-msvideo"},
-    {"spx", "audio/ogg"},
-    {"xfdl", "application/vnd.xfdl"},
-    {"wrl", "model/vrml"},
-    {"conf", "text/plain"},
-    {"tar", "application/x-tar"},
-    {"mpg", "video/mpeg"},
-    {"spp", "application/scvp-vp-response"},
-    {"spq", "application/scvp-vp-request"},
-    {"dxr", "application/x-director"},
-    {"dxp", "application/vnd.spotfire.dxp"},
-    {"mqy", "application/vnd.mobius.mqy"},
-    {"mjp2", "video/mj2"},
-    {"spl", "application/x-futuresplash"},
-    {"dxf", "image/vnd.dxf"},
-    {"tao", "application/vnd.tao.intent-module-archive"},
-    {"spf", "application/vnd.yamaha.smaf-phrase"},
-    {"yang", "application/yang"},
-    {"sis", "application/vnd.symbian.install"},
-    {"afm", "application/x-font-type1"},
-    {"chrt", "application/vnd.kde.kchart"},
-    {"csh", "application/x-csh"},
-    {"sit", "application/x-stuffit"},
-    {"rmvb", "application/vnd.rn-realmedia-vbr"},
-    {"ogv", "video/ogg"},
-    {"wax", "audio/x-ms-wax"},
-    {"sig", "application/pgp-signature"},
-    {"dwg", "image/vnd.dwg"},
-    {"mj2", "video/mj2"},
-    {"sid", "image/x-mrsid-image"},
-    {"cst", "application/x-director"},
-    {"xhtml", "application/xhtml+xml"},
-    {"xm", "audio/xm"},
-    {"afp", "application/vnd.ibm.modcap"},
-    {"csp", "application/vnd.commonspace"},
-    {"css", "text/css"},
-    {"sil", "audio/silk"},
-    {"snf", "application/x-font-snf"},
-    {"pqa", "application/vnd.palm"},
-    {"snd", "audio/basic"},
-    {"mar", "application/octet-stream"},
-    {"srt", "application/x-subrip"},
-    {"spot", "text/vnd.in3d.spot"},
-    {"spc", "application/x-pkcs7-certificates"},
-    {"mesh", "model/mesh"},
-    {"npx", "image/vnd.net-fpx"},
-    {"mag", "application/vnd.ecowin.chart"},
-    {"xvml", "application/xv+xml"},
-    {"inkml", "application/inkml+xml"},
-    {"fm", "application/vnd.framemaker"},
-    {"man", "text/troff"},
-    {"lha", "application/x-lzh-compressed"},
-    {"st", "application/vnd.sailingtracker.track"},
-    {"ghf", "application/vnd.groove-help"},
-    {"mgp", "application/vnd.osgeo.mapguide.package"},
-    {"so", "application/octet-stream"},
-    {"sm", "application/vnd.stepmania.stepchart"},
-    {"sc", "application/vnd.ibm.secure-container"},
-    {"uvx", "application/vnd.dece.unspecified"},
-    {"uvz", "application/vnd.dece.zip"},
-    {"xhvml", "application/xv+xml"},
-    {"mpp", "application/vnd.ms-project"},
-    {"uvp", "video/vnd.dece.pd"},
-    {"uvs", "video/vnd.dece.sd"},
-    {"uvt", "application/vnd.dece.ttml+xml"},
-    {"uvu", "video/vnd.uvvu.mp4"},
-    {"jpeg", "image/jpeg"},
-    {"mmr", "image/vnd.fujixerox.edmics-mmr"},
-    {"uvh", "video/vnd.dece.hd"},
-    {"uvi", "image/vnd.dece.graphic"},
-    {"flv", "video/x-flv"},
-    {"list3820", "application/vnd.ibm.modcap"},
-    {"uvm", "video/vnd.dece.mobile"},
-    {"ttl", "text/turtle"},
-    {"ttc", "application/x-font-ttf"},
-    {"uva", "audio/vnd.dece.audio"},
-    {"uvd", "application/vnd.dece.data"},
-    {"ttf", "application/x-font-ttf"},
-    {"uvf", "application/vnd.dece.data"},
-    {"xo", "application/vnd.olpc-sugar"},
-    {"joda", "application/vnd.joost.joda-archive"},
-    {"pcx", "image/x-pcx"},
-    {"h263", "video/h263"},
-    {"djv", "image/vnd.djvu"},
-    {"tsd", "application/timestamped-data"},
-    {"mbk", "application/vnd.mobius.mbk"},
-    {"cla", "application/vnd.claymore"},
-    {"pct", "image/x-pict"},
-    {"wri", "application/x-mswrite"},
-    {"imp", "application/vnd.accpac.simply.imp"},
-    {"ims", "application/vnd.ms-ims"},
-    {"xpm", "image/x-xpixmap"},
-    {"vtu", "model/vnd.vtu"},
-    {"fig", "application/x-xfig"},
-    {"pcl", "application/vnd.hp-pcl"},
-    {"gtw", "model/vnd.gtw"},
-    {"tsv", "text/tab-separated-values"},
-    {"dwf", "model/vnd.dwf"},
-    {"silo", "model/mesh"},
-    {"pcf", "application/x-font-pcf"},
-    {"pptx", "application/vnd.openxmlformats-officedocument.presentationml.presentation"},
-    {"mp2a", "audio/mpeg"},
-    {"daf", "application/vnd.mobius.daf"},
-    {"nsc", "application/x-conference"},
-    {"mk3d", "video/x-matroska"},
-    {"taglet", "application/vnd.mynfc"},
-    {"mp4a", "audio/mp4"},
-    {"mseed", "application/vnd.fdsn.mseed"},
-    {"mxs", "application/vnd.triscape.mxs"},
-    {"p10", "application/pkcs10"},
-    {"karbon", "application/vnd.kde.karbon"},
-    {"mxl", "application/vnd.recordare.musicxml"},
-    {"cer", "application/pkix-cert"},
-    {"docm", "application/vnd.ms-word.document.macroenabled.12"},
-    {"mxf", "application/mxf"},
-    {"qt", "video/quicktime"},
-    {"hqx", "application/mac-binhex40"},
-    {"pps", "application/vnd.ms-powerpoint"},
-    {"kpr", "application/vnd.kde.kpresenter"},
-    {"mods", "application/mods+xml"},
-    {"kpt", "application/vnd.kde.kpresenter"},
-    {"f4v", "video/x-f4v"},
-    {"nfo", "text/x-nfo"},
-    {"xlf", "application/x-xliff+xml"},
-    {"xlc", "application/vnd.ms-excel"},
-    {"xla", "application/vnd.ms-excel"},
-    {"fpx", "image/vnd.fpx"},
-    {"3ds", "image/x-3ds"},
-    {"ifb", "text/calendar"},
-    {"eml", "message/rfc822"},
-    {"xlw", "application/vnd.ms-excel"},
-    {"ifm", "application/vnd.shana.informed.formdata"},
-    {"xlt", "application/vnd.ms-excel"},
-    {"xls", "application/vnd.ms-excel"},
-    {"csv", "text/csv"},
-    {"atomcat", "application/atomcat+xml"},
-    {"mets", "application/mets+xml"},
-    {"mdi", "image/vnd.ms-modi"},
-    {"uvvu", "video/vnd.uvvu.mp4"},
-    {"dgc", "application/x-dgc-compressed"},
-    {"mrcx", "application/marcxml+xml"},
-    {"list", "text/plain"},
-    {"x3dbz", "model/x3d+binary"},
-    {"hlp", "application/winhlp"},
-    {"gtar", "application/x-gtar"},
-    {"ez", "application/andrew-inset"},
-    {"mxml", "application/xv+xml"},
-    {"dic", "text/x-c"},
-    {"wqd", "application/vnd.wqd"},
-    {"vcd", "application/x-cdlink"},
-    {"rq", "application/sparql-query"},
-    {"vcf", "text/x-vcard"},
-    {"rs", "application/rls-services+xml"},
-    {"res", "application/x-dtbresource+xml"},
-    {"rep", "application/vnd.businessobjects"},
-    {"cww", "application/prs.cww"},
-    {"wgt", "application/widget"},
-    {"ftc", "application/vnd.fluxtime.clip"},
-    {"vcs", "text/x-vcalendar"},
-    {"nitf", "application/vnd.nitf"},
-    {"smi", "application/smil+xml"},
-    {"3gp", "video/3gpp"},
-    {"fti", "application/vnd.anser-web-funds-transfer-initiation"},
-    {"rm", "application/vnd.rn-realmedia"},
-    {"roff", "text/troff"},
-    {"m2a", "audio/mpeg"},
-    {"blb", "application/x-blorb"},
-    {"dataless", "application/vnd.fdsn.seed"},
-    {"crd", "application/x-mscardfile"},
-    {"rld", "application/resource-lists-diff+xml"},
-    {"cmx", "image/x-cmx"},
-    {"p7r", "application/x-pkcs7-certreqresp"},
-    {"pub", "application/x-mspublisher"},
-    {"sh", "application/x-sh"},
-    {"asc", "application/pgp-signature"},
-    {"mime", "message/rfc822"},
-    {"asf", "video/x-ms-asf"},
-    {"org", "application/vnd.lotus-organizer"},
-    {"mmf", "application/vnd.smaf"},
-    {"aso", "application/vnd.accpac.simply.aso"},
-    {"asm", "text/x-asm"},
-    {"ntf", "application/vnd.nitf"},
-    {"java", "text/x-java-source"},
-    {"pkipath", "application/pkix-pkipath"},
-    {"atc", "application/vnd.acucorp"},
-    {"midi", "audio/midi"},
-    {"potx", "application/vnd.openxmlformats-officedocument.presentationml.template"},
-    {"m21", "application/mp21"},
-    {"mvb", "application/x-msmediaview"},
-    {"iso", "application/x-iso9660-image"},
-    {"ltf", "application/vnd.frogans.ltf"},
-    {"xul", "application/vnd.mozilla.xul+xml"},
-    {"cdkey", "application/vnd.mediastation.cdkey"},
-    {"gif", "image/gif"},
-    {"atx", "application/vnd.antix.game-component"},
-    {"uvva", "audio/vnd.dece.audio"},
-    {"uvvg", "image/vnd.dece.graphic"},
-    {"uvvf", "application/vnd.dece.data"},
-    {"uvvd", "application/vnd.dece.data"},
-    {"pgn", "application/x-chess-pgn"},
-    {"uvvi", "image/vnd.dece.graphic"},
-    {"pgm", "image/x-portable-graymap"},
-    {"htke", "application/vnd.kenameaapp"},
-    {"uvvm", "video/vnd.dece.mobile"},
-    {"xz", "application/x-xz"},
-    {"fh", "image/x-freehand"},
-    {"uvvp", "video/vnd.dece.pd"},
-    {"zaz", "application/vnd.zzazz.deck+xml"},
-    {"uvvv", "video/vnd.dece.video"},
-    {"pgp", "application/pgp-encrypted"},
-    {"uvvt", "application/vnd.dece.ttml+xml"},
-    {"rcprofile", "application/vnd.ipunplugged.rcprofile"},
-    {"uvvx", "application/vnd.dece.unspecified"},
-    {"x3dz", "model/x3d+xml"},
-    {"gph", "application/vnd.flographit"},
-    {"xif", "image/vnd.xiff"},
-    {"kon", "application/vnd.kde.kontour"},
-    {"yin", "application/yin+xml"},
-    {"x3dv", "model/x3d+vrml"},
-    {"ptid", "application/vnd.pvi.ptid1"},
-    {"potm", "application/vnd.ms-powerpoint.template.macroenabled.12"},
-    {"gpx", "application/gpx+xml"},
-    {"svgz", "image/svg+xml"},
-    {"cdxml", "application/vnd.chemdraw+xml"},
-    {"iota", "application/vnd.astraea-software.iota"},
-    {"ncx", "application/x-dtbncx+xml"},
-    {"nbp", "application/vnd.wolfram.player"},
-    {"tfi", "application/thraud+xml"},
-    {"ogx", "application/ogg"},
-    {"f90", "text/x-fortran"},
-    {"rsd", "application/rsd+xml"},
-    {"msl", "application/vnd.mobius.msl"},
-    {"bcpio", "application/x-bcpio"},
-    {"zirz", "application/vnd.zul"},
-    {"onetoc2", "application/onenote"},
-    {"cbz", "application/x-cbr"},
-    {"p12", "application/x-pkcs12"},
-    {"pnm", "image/x-portable-anymap"},
-    {"wav", "audio/x-wav"},
-    {"ogg", "audio/ogg"},
-    {"oga", "audio/ogg"},
-    {"png", "image/png"},
-    {"rss", "application/rss+xml"},
-    {"std", "application/vnd.sun.xml.draw.template"},
-    {"onetmp", "application/onenote"},
-    {"stf", "application/vnd.wt.stf"},
-    {"ktx", "image/ktx"},
-    {"ktz", "application/vnd.kahootz"},
-    {"odft", "application/vnd.oasis.opendocument.formula-template"},
-    {"stl", "application/vnd.ms-pki.stl"},
-    {"dtb", "application/x-dtbook+xml"},
-    {"sti", "application/vnd.sun.xml.impress.template"},
-    {"ktr", "application/vnd.kahootz"},
-    {"stk", "application/hyperstudio"},
-    {"nzb", "application/x-nzb"},
-    {"stw", "application/vnd.sun.xml.writer.template"},
-    {"str", "application/vnd.pg.format"},
-    {"dts", "audio/vnd.dts"},
-    {"fe_launch", "application/vnd.denovo.fcselayout-link"},
-    {"h", "text/x-c"},
-    {"torrent", "application/x-bittorrent"},
-    {"mov", "video/quicktime"},
-    {"ecelp9600", "audio/vnd.nuera.ecelp9600"},
-    {"pre", "application/vnd.lotus-freelance"},
-    {"tfm", "application/x-tex-tfm"},
-    {"prf", "application/pics-rules"},
-    {"n-gage", "application/vnd.nokia.n-gage.symbian.install"},
-    {"prc", "application/x-mobipocket-ebook"},
-    {"ram", "audio/x-pn-realaudio"},
-    {"saf", "application/vnd.yamaha.smaf-audio"},
-    {"seed", "application/vnd.fdsn.seed"},
-    {"lbe", "application/vnd.llamagraphics.life-balance.exchange+xml"},
-    {"lbd", "application/vnd.llamagraphics.life-balance.desktop"},
-    {"qps", "application/vnd.publishare-delta-tree"},
-    {"atomsvc", "application/atomsvc+xml"},
-    {"7z", "application/x-7z-compressed"},
-    {"mseq", "application/vnd.mseq"},
-    {"rmi", "audio/midi"},
-    {"bz2", "application/x-bzip2"},
-    {"3dml", "text/vnd.in3d.3dml"},
-    {"ngdat", "application/vnd.nokia.n-gage.data"},
-    {"mie", "application/x-mie"},
-    {"fxp", "application/vnd.adobe.fxp"},
-    {"teicorpus", "application/tei+xml"},
-    {"listafp", "application/vnd.ibm.modcap"},
-    {"z1", "application/x-zmachine"},
-    {"stc", "application/vnd.sun.xml.calc.template"},
-    {"meta4", "application/metalink4+xml"},
-    {"aifc", "audio/x-aiff"},
-    {"3g2", "video/3gpp2"},
-    {"wcm", "application/vnd.ms-works"},
-    {"csml", "chemical/x-csml"},
-    {"fcs", "application/vnd.isac.fcs"},
-    {"xdssc", "application/dssc+xml"},
-    {"deploy", "application/octet-stream"},
-    {"sfv", "text/x-sfv"},
-    {"rpst", "application/vnd.nokia.radio-preset"},
-    {"sfs", "application/vnd.spotfire.sfs"},
-    {"pyv", "video/vnd.ms-playready.media.pyv"},
-    {"pptm", "application/vnd.ms-powerpoint.presentation.macroenabled.12"},
-    {"kar", "audio/midi"},
-    {"mpeg", "video/mpeg"},
-    {"sisx", "application/vnd.symbian.install"},
-    {"pya", "audio/vnd.ms-playready.media.pya"},
-    {"bh2", "application/vnd.fujitsu.oasysprs"},
-    {"class", "application/java-vm"},
-    {"epub", "application/epub+zip"},
-    {"latex", "application/x-latex"},
-    {"exe", "application/x-msdownload"},
-    {"doc", "application/msword"},
-    {"tpl", "application/vnd.groove-tool-template"},
-    {"uri", "text/uri-list"},
-    {"exi", "application/exi"},
-    {"ext", "application/vnd.novadigm.ext"},
-    {"tpt", "application/vnd.trid.tpt"},
-    {"efif", "application/vnd.picsel"},
-    {"movie", "video/x-sgi-movie"},
-    {"dot", "application/msword"},
-    {"qbo", "application/vnd.intu.qbo"},
-    {"dbk", "application/docbook+xml"},
-    {"rtf", "application/rtf"},
-    {"nlu", "application/vnd.neurolanguage.nlu"},
-    {"text", "text/plain"},
-    {"sdc", "application/vnd.stardivision.calc"},
-    {"pskcxml", "application/pskc+xml"},
-    {"texi", "application/x-texinfo"},
-    {"pkg", "application/octet-stream"},
-    {"itp", "application/vnd.shana.informed.formtemplate"},
-    {"pki", "application/pkixcmp"},
-    {"cdx", "chemical/x-cdx"},
-    {"cdy", "application/vnd.cinderella"},
-    {"xml", "application/xml"},
-    {"ksp", "application/vnd.kde.kspread"},
-    {"jar", "application/java-archive"},
-    {"mp21", "application/mp21"},
-    {"jam", "application/vnd.jam"},
-    {"jad", "text/vnd.sun.j2me.app-descriptor"},
-    {"ief", "image/ief"},
-    {"xdf", "application/xcap-diff+xml"},
-    {"xdm", "application/vnd.syncml.dm+xml"},
-    {"gex", "application/vnd.geometry-explorer"},
-    {"cpio", "application/x-cpio"},
-    {"p", "text/x-pascal"},
-    {"omdoc", "application/omdoc+xml"},
-    {"xdw", "application/vnd.fujixerox.docuworks"},
-    {"123", "application/vnd.lotus-1-2-3"},
-    {"uvv", "video/vnd.dece.video"},
-    {"chat", "application/x-chat"},
-    {"xdp", "application/vnd.adobe.xdp+xml"},
-    {"sse", "application/vnd.kodak-descriptor"},
-    {"mgz", "application/vnd.proteus.magazine"},
-    {"ssf", "application/vnd.epson.ssf"},
-    {"geo", "application/vnd.dynageo"},
-    {"dp", "application/vnd.osgi.dp"},
-    {"cif", "chemical/x-cif"},
-    {"musicxml", "application/vnd.recordare.musicxml+xml"},
-    {"aep", "application/vnd.audiograph"},
-    {"bat", "application/x-msdownload"},
-    {"emf", "application/x-msmetafile"},
-    {"smzip", "application/vnd.stepmania.package"},
-    {"aac", "audio/x-aac"},
-    {"crt", "application/x-x509-ca-cert"},
-    {"oxt", "application/vnd.openofficeorg.extension"},
-    {"scd", "application/x-msschedule"},
-    {"metalink", "application/metalink+xml"},
-    {"dpg", "application/vnd.dpgraph"},
-    {"aam", "application/x-authorware-map"},
-    {"gbr", "application/rpki-ghostbusters"},
-    {"gram", "application/srgs"},
-    {"shf", "application/shf+xml"},
-    {"crl", "application/pkix-crl"},
-    {"emz", "application/x-msmetafile"},
-    {"rms", "application/vnd.jcp.javame.midlet-rms"},
-    {"rmp", "audio/x-pn-realaudio-plugin"},
-    {"ser", "application/java-serialized-object"},
-    {"dump", "application/octet-stream"},
-    {"fg5", "application/vnd.fujitsu.oasysgp"},
-    {"frame", "application/vnd.framemaker"},
-    {"vis", "application/vnd.visionary"},
-    {"dmg", "application/x-apple-diskimage"},
-    {"see", "application/vnd.seemail"},
-    {"pvb", "application/vnd.3gpp.pic-bw-var"},
-    {"hpgl", "application/vnd.hp-hpgl"},
-    {"lnk", "application/x-ms-shortcut"},
-    {"cryptonote", "application/vnd.rig.cryptonote"},
-    {"dtd", "application/xml-dtd"},
-    {"susp", "application/vnd.sus-calendar"},
-    {"cmp", "application/vnd.yellowriver-custom-menu"},
-    {"et3", "application/vnd.eszigno3+xml"},
-    {"uris", "text/uri-list"},
-    {"mus", "application/vnd.musician"},
-    {"irp", "application/vnd.irepository.package+xml"},
-    {"gramps", "application/x-gramps-xml"},
-    {"osfpvg", "application/vnd.yamaha.openscoreformat.osfpvg+xml"},
-    {"xvm", "application/xv+xml"},
-    {"irm", "application/vnd.ibm.rights-management"},
-    {"otc", "application/vnd.oasis.opendocument.chart-template"},
-    {"uvg", "image/vnd.dece.graphic"},
-    {"wg", "application/vnd.pmi.widget"},
-    {"cdmia", "application/cdmi-capability"},
-    {"cdmic", "application/cdmi-container"},
-    {"cdmid", "application/cdmi-domain"},
-    {"bed", "application/vnd.realvnc.bed"},
-    {"xslt", "application/xslt+xml"},
-    {"h264", "video/h264"},
-    {"boz", "application/x-bzip2"},
-    {"wm", "video/x-ms-wm"},
-    {"f77", "text/x-fortran"},
-    {"cdmio", "application/cdmi-object"},
-    {"cdmiq", "application/cdmi-queue"},
-    {"wtb", "application/vnd.webturbo"},
-    {"vcx", "application/vnd.vcx"},
-    {"fgd", "application/x-director"},
-    {"js", "application/javascript"},
-    {"pcap", "application/vnd.tcpdump.pcap"},
-    {"xwd", "image/x-xwindowdump"},
-    {"c", "text/x-c"},
-    {"qfx", "application/vnd.intu.qfx"},
-    {"adp", "audio/adpcm"},
-    {"etx", "text/x-setext"},
-    {"xlam", "application/vnd.ms-excel.addin.macroenabled.12"},
-    {"s", "text/x-asm"},
-    {"fnc", "application/vnd.frogans.fnc"},
-    {"cod", "application/vnd.rim.cod"},
-    {"urls", "text/uri-list"},
-    {"pdf", "application/pdf"},
-    {"com", "application/x-msdownload"},
-    {"pdb", "application/vnd.palm"},
-    {"ecma", "application/ecmascript"},
-    {"xltm", "application/vnd.ms-excel.template.macroenabled.12"},
-    {"gxf", "application/gxf"},
-    {"cxt", "application/x-director"},
-    {"kwd", "application/vnd.kde.kword"},
-    {"cc", "text/x-c"},
-    {"pot", "application/vnd.ms-powerpoint"},
-    {"kfo", "application/vnd.kde.kformula"},
-    {"hvd", "application/vnd.yamaha.hv-dic"},
-    {"gtm", "application/vnd.groove-tool-message"},
-    {"gxt", "application/vnd.geonext"},
-    {"m13", "application/x-msmediaview"},
-    {"cba", "application/x-cbr"},
-    {"xltx", "application/vnd.openxmlformats-officedocument.spreadsheetml.template"},
-    {"kwt", "application/vnd.kde.kword"},
-    {"hvp", "application/vnd.yamaha.hv-voice"},
-    {"hvs", "application/vnd.yamaha.hv-script"},
-    {"cu", "application/cu-seeme"},
-    {"ppsx", "application/vnd.openxmlformats-officedocument.presentationml.slideshow"},
-    {"swi", "application/vnd.aristanetworks.swi"},
-    {"ps", "application/postscript"},
-    {"sv4crc", "application/x-sv4crc"},
-    {"dotx", "application/vnd.openxmlformats-officedocument.wordprocessingml.template"},
-    {"ei6", "application/vnd.pg.osasli"},
-    {"swa", "application/x-director"},
-    {"xar", "application/vnd.xara"},
-    {"dis", "application/vnd.mobius.dis"},
-    {"swf", "application/x-shockwave-flash"},
-    {"json", "application/json"},
-    {"hpid", "application/vnd.hp-hpid"},
-    {"oth", "application/vnd.oasis.opendocument.text-web"},
-    {"oti", "application/vnd.oasis.opendocument.image-template"},
-    {"nnd", "application/vnd.noblenet-directory"},
-    {"rp9", "application/vnd.cloanto.rp9"},
-    {"mcd", "application/vnd.mcd"},
-    {"sldx", "application/vnd.openxmlformats-officedocument.presentationml.slide"},
-    {"otf", "application/x-font-otf"},
-    {"otg", "application/vnd.oasis.opendocument.graphics-template"},
-    {"gam", "application/x-tads"},
-    {"xlsm", "application/vnd.ms-excel.sheet.macroenabled.12"},
-    {"m1v", "video/mpeg"},
-    {"sldm", "application/vnd.ms-powerpoint.slide.macroenabled.12"},
-    {"xlsb", "application/vnd.ms-excel.sheet.binary.macroenabled.12"},
-    {"gac", "application/vnd.groove-account"},
-    {"dotm", "application/vnd.ms-word.template.macroenabled.12"},
-    {"cbr", "application/x-cbr"},
-    {"slt", "application/vnd.epson.salt"},
-    {"ait", "application/vnd.dvb.ait"},
-    {"p8", "application/pkcs8"},
-    {"air", "application/vnd.adobe.air-application-installer-package+zip"},
-    {"hdf", "application/x-hdf"},
-    {"mlp", "application/vnd.dolby.mlp"},
-    {"sdkd", "application/vnd.solent.sdkm+xml"},
-    {"mpg4", "video/mp4"},
-    {"rar", "application/x-rar-compressed"},
-    {"aif", "audio/x-aiff"},
-    {"mbox", "application/mbox"},
-    {"sdkm", "application/vnd.solent.sdkm+xml"},
-    {"ras", "image/x-cmu-raster"},
-    {"ami", "application/vnd.amiga.ami"},
-    {"jpm", "video/jpm"},
-    {"cbt", "application/x-cbr"},
-    {"vob", "video/x-ms-vob"},
-    {"dae", "model/vnd.collada+xml"},
-    {"sxw", "application/vnd.sun.xml.writer"},
-    {"jpe", "image/jpeg"},
-    {"docx", "application/vnd.openxmlformats-officedocument.wordprocessingml.document"},
-    {"rip", "audio/vnd.rip"},
-    {"sitx", "application/x-stuffitx"},
-    {"ivu", "application/vnd.immervision-ivu"},
-    {"ivp", "application/vnd.immervision-ivp"},
-    {"jpgv", "video/jpeg"},
-    {"vor", "application/vnd.stardivision.writer"},
-    {"in", "text/plain"},
-    {"rif", "application/reginfo+xml"},
-    {"wks", "application/vnd.ms-works"},
-    {"vox", "application/x-authorware-bin"},
-    {"shar", "application/x-shar"},
-    {"wmx", "video/x-ms-wmx"},
-    {"pas", "text/x-pascal"},
-    {"blorb", "application/x-blorb"},
-    {"paw", "application/vnd.pawaafile"},
-    {"psb", "application/vnd.3gpp.pic-bw-small"},
-    {"html", "text/html"},
-    {"wspolicy", "application/wspolicy+xml"},
-    {"qam", "application/vnd.epson.quickanime"},
-    {"texinfo", "application/x-texinfo"},
-    {"gnumeric", "application/x-gnumeric"},
-    {"vsd", "application/vnd.visio"},
-    {"mxu", "video/vnd.mpegurl"},
-    {"x3dvz", "model/x3d+vrml"},
-    {"jsonml", "application/jsonml+json"},
-    {"xbap", "application/x-ms-xbap"},
-    {"wps", "application/vnd.ms-works"},
-    {"wpl", "application/vnd.ms-wpl"},
-    {"unityweb", "application/vnd.unity"},
-    {"ecelp7470", "audio/vnd.nuera.ecelp7470"},
-    {"wpd", "application/vnd.wordperfect"},
-    {"kia", "application/vnd.kidspiration"},
-    {"mobi", "application/x-mobipocket-ebook"},
-    {"opml", "text/x-opml"},
-    {"lzh", "application/x-lzh-compressed"},
-    {"cct", "application/x-director"},
-    {"kne", "application/vnd.kinar"},
-    {"eps", "application/postscript"},
-    {"log", "text/plain"},
-    {"gsf", "application/x-font-ghostscript"},
-    {"cdbcmsg", "application/vnd.contact.cmsg"},
-    {"wmlc", "application/vnd.wap.wmlc"},
-    {"knp", "application/vnd.kinar"},
-    {"i2g", "application/vnd.intergeo"},
-    {"mp4v", "video/mp4"},
-    {"mp4s", "application/mp4"},
-    {"evy", "application/x-envoy"},
-    {"aiff", "audio/x-aiff"},
-    {"davmount", "application/davmount+xml"},
-    {"mfm", "application/vnd.mfmp"},
-    {"mid", "audio/midi"},
-    {"ecelp4800", "audio/vnd.nuera.ecelp4800"},
-    {"tcl", "application/x-tcl"},
-    {"mft", "application/rpki-manifest"},
-    {"xer", "application/patch-ops-error+xml"},
-    {"mif", "application/vnd.mif"},
-    {"gdl", "model/vnd.gdl"},
-    {"msty", "application/vnd.muvee.style"},
-    {"skt", "application/vnd.koan"},
-    {"hal", "application/vnd.hal+xml"},
-    {"skp", "application/vnd.koan"},
-    {"g3w", "application/vnd.geospace"},
-    {"gml", "application/gml+xml"},
-    {"elc", "application/octet-stream"},
-    {"dtshd", "audio/vnd.dts.hd"},
-    {"m4v", "video/x-m4v"},
-    {"m4u", "video/vnd.mpegurl"},
-    {"skd", "application/vnd.koan"},
-    {"rgb", "image/x-rgb"},
-    {"gmx", "application/vnd.gmx"},
-    {"ipk", "application/vnd.shana.informed.package"},
-    {"skm", "application/vnd.koan"},
-    {"ccxml", "application/ccxml+xml"},
-    {"fvt", "video/vnd.fvt"},
-    {"xenc", "application/xenc+xml"},
-    {"bin", "application/octet-stream"},
-    {"dsc", "text/prs.lines.tag"},
-    {"ufdl", "application/vnd.ufdl"},
-    {"rnc", "application/relax-ng-compact-syntax"},
-    {"qwd", "application/vnd.quark.quarkxpress"},
-    {"psf", "application/x-font-linux-psf"},
-    {"xlm", "application/vnd.ms-excel"},
-    {"lostxml", "application/lost+xml"},
-    {"dart", "application/vnd.dart"},
-    {"opf", "application/oebps-package+xml"},
-    {"ra", "audio/x-pn-realaudio"},
-    {"ustar", "application/x-ustar"},
-    {"qwt", "application/vnd.quark.quarkxpress"},
-    {"tif", "image/tiff"},
-    {"c11amz", "application/vnd.cluetrust.cartomobile-config-pkg"},
-    {"qxb", "application/vnd.quark.quarkxpress"},
-    {"emma", "application/emma+xml"},
-    {"wbs", "application/vnd.criticaltools.wbs+xml"},
-    {"qxd", "application/vnd.quark.quarkxpress"},
-    {"acutc", "application/vnd.acucorp"},
-    {"oprc", "application/vnd.palm"},
-    {"semf", "application/vnd.semf"},
-    {"bpk", "application/octet-stream"},
-    {"semd", "application/vnd.semd"},
-    {"qxl", "application/vnd.quark.quarkxpress"},
-    {"dvb", "video/vnd.dvb.file"},
-    {"arc", "application/x-freearc"},
-    {"tga", "image/x-tga"},
-    {"t", "text/troff"},
-    {"qxt", "application/vnd.quark.quarkxpress"},
-    {"viv", "video/vnd.vivo"},
-    {"c11amc", "application/vnd.cluetrust.cartomobile-config"},
-    {"mkv", "video/x-matroska"},
-    {"xsl", "application/xml"},
-    {"xsm", "application/vnd.syncml+xml"},
-    {"scurl", "text/vnd.curl.scurl"},
-    {"jlt", "application/vnd.hp-jlyt"},
-    {"vss", "application/vnd.visio"},
-    {"vst", "application/vnd.visio"},
-    {"vsw", "application/vnd.visio"},
-    {"webm", "video/webm"},
-    {"webp", "image/webp"},
-    {"sxg", "application/vnd.sun.xml.writer.global"},
-    {"sema", "application/vnd.sema"},
-    {"vsf", "application/vnd.vsf"},
-    {"udeb", "application/x-debian-package"},
-    {"psd", "image/vnd.adobe.photoshop"},
-    {"umj", "application/vnd.umajin"},
-    {"ico", "image/x-icon"},
-    {"icm", "application/vnd.iccprofile"},
-    {"icc", "application/vnd.iccprofile"},
-    {"kml", "application/vnd.google-earth.kml+xml"},
-    {"ice", "x-conference/x-cooltalk"},
-    {"n3", "text/n3"},
-    {"esf", "application/vnd.epson.esf"},
-    {"cgm", "image/cgm"},
-    {"aab", "application/x-authorware-bin"},
-    {"mc1", "application/vnd.medcalcdata"},
-    {"esa", "application/vnd.osgi.subsystem"},
-    {"ics", "text/calendar"},
-    {"kmz", "application/vnd.google-earth.kmz"},
-    {"s3m", "audio/s3m"},
-    {"ddd", "application/vnd.fujixerox.ddd"},
-    {"jnlp", "application/x-java-jnlp-file"},
-    {"pls", "application/pls+xml"},
-    {"m3u8", "application/vnd.apple.mpegurl"},
-    {"ufd", "application/vnd.ufdl"},
-    {"x3db", "model/x3d+binary"},
-    {"ez2", "application/vnd.ezpix-album"},
-    {"ez3", "application/vnd.ezpix-package"},
-    {"plf", "application/vnd.pocketlearn"},
-    {"mpga", "audio/mpeg"},
-    {"plc", "application/vnd.mobius.plc"},
-    {"plb", "application/vnd.3gpp.pic-bw-large"},
-    {"twds", "application/vnd.simtech-mindmapper"},
-    {"c4p", "application/vnd.clonk.c4group"},
-    {"nml", "application/vnd.enliven"},
-    {"iges", "model/iges"},
-    {"dcr", "application/x-director"},
-    {"bz", "application/x-bzip"},
-    {"acc", "application/vnd.americandynamics.acc"},
-    {"src", "application/x-wais-source"},
-    {"ppm", "image/x-portable-pixmap"},
-    {"es3", "application/vnd.eszigno3+xml"},
-    {"zip", "application/zip"},
-    {"ace", "application/x-ace-compressed"},
-    {"uvvh", "video/vnd.dece.hd"},
-    {"dd2", "application/vnd.oma.dd2+xml"},
-    {"obd", "application/x-msbinder"},
-    {"cmdf", "chemical/x-cmdf"},
-    {"wmlsc", "application/vnd.wap.wmlscriptc"},
-    {"xap", "application/x-silverlight-app"},
-    {"acu", "application/vnd.acucobol"},
-    {"sru", "application/sru+xml"},
-    {"srx", "application/sparql-results+xml"},
-    {"book", "application/vnd.framemaker"},
-    {"clkk", "application/vnd.crick.clicker.keyboard"},
-    {"ppd", "application/vnd.cups-ppd"},
-    {"tiff", "image/tiff"},
-    {"xyz", "chemical/x-xyz"},
-    {"pcurl", "application/vnd.curl.pcurl"},
-    {"cpp", "text/x-c"},
-    {"nsf", "application/vnd.lotus-notes"},
-    {"clkx", "application/vnd.crick.clicker"},
-    {"weba", "audio/webm"},
-    {"ppt", "application/vnd.ms-powerpoint"},
-    {"clkp", "application/vnd.crick.clicker.palette"},
-    {"dfac", "application/vnd.dreamfactory"},
-    {"clkt", "application/vnd.crick.clicker.template"},
-    {"djvu", "image/vnd.djvu"},
-    {"clkw", "application/vnd.crick.clicker.wordbank"},
-    {"xpi", "application/x-xpinstall"},
-    {"w3d", "application/x-director"},
-    {"mka", "audio/x-matroska"},
-    {"xpl", "application/xproc+xml"},
-    {"fzs", "application/vnd.fuzzysheet"},
-    {"ppam", "application/vnd.ms-powerpoint.addin.macroenabled.12"},
-    {"wad", "application/x-doom"},
-    {"setpay", "application/set-payment-initiation"},
-    {"pic", "image/x-pict"},
-    {"mdb", "application/x-msaccess"},
-    {"xpx", "application/vnd.intercon.formnet"},
-    {"mks", "video/x-matroska"},
-    {"fcdt", "application/vnd.adobe.formscentral.fcdt"},
-    {"smil", "application/smil+xml"},
-    {"xps", "application/vnd.ms-xpsdocument"},
-    {"xpr", "application/vnd.is-xpr"},
-    {"gim", "application/vnd.groove-identity-message"},
-    {"xpw", "application/vnd.intercon.formnet"},
-    {"wmls", "text/vnd.wap.wmlscript"},
-    {"sdw", "application/vnd.stardivision.writer"},
-    {"sdp", "application/sdp"},
-    {"ipfix", "application/ipfix"},
-    {"sdd", "application/vnd.stardivision.impress"},
-    {"hh", "text/x-c"},
-    {"sda", "application/vnd.stardivision.draw"},
-    {"atom", "application/atom+xml"},
-    {"pwn", "application/vnd.3m.post-it-notes"},
-    {"mscml", "application/mediaservercontrol+xml"},
-    {"sv4cpio", "application/x-sv4cpio"},
-    {"mathml", "application/mathml+xml"},
-    {"m14", "application/x-msmediaview"},
-    {"lvp", "audio/vnd.lucent.voice"},
-    {"fdf", "application/vnd.fdf"},
-    {"uu", "text/x-uuencode"},
-    {"mts", "model/vnd.mts"},
-    {"cii", "application/vnd.anser-web-certificate-issue-initiation"},
-    {"sgml", "text/sgml"},
-    {"azf", "application/vnd.airzip.filesecure.azf"},
-    {"cil", "application/vnd.ms-artgalry"},
-    {"dmp", "application/vnd.tcpdump.pcap"},
-    {"dms", "application/octet-stream"},
-    {"clp", "application/x-msclip"},
-    {"mads", "application/mads+xml"},
-    {"svg", "image/svg+xml"},
-    {"utz", "application/vnd.uiq.theme"},
-    {"odt", "application/vnd.oasis.opendocument.text"},
-    {"oxps", "application/oxps"},
-    {"azs", "application/vnd.airzip.filesecure.azs"},
-    {"uvvs", "video/vnd.dece.sd"},
-    {"azw", "application/vnd.amazon.ebook"},
-    {"ac", "application/pkix-attr-cert"},
-    {"sxc", "application/vnd.sun.xml.calc"},
-    {"sxd", "application/vnd.sun.xml.draw"},
-    {"p7s", "application/pkcs7-signature"},
-    {"xlsx", "application/vnd.openxmlformats-officedocument.spreadsheetml.sheet"},
-    {"ai", "application/postscript"},
-    {"sxi", "application/vnd.sun.xml.impress"},
-    {"grxml", "application/srgs+xml"},
-    {"sxm", "application/vnd.sun.xml.math"},
-    {"dssc", "application/dssc+der"},
-    {"ppsm", "application/vnd.ms-powerpoint.slideshow.macroenabled.12"},
-    {"fly", "text/vnd.fly"},
-    {"gca", "application/x-gca-compressed"},
-    {"p7b", "application/x-pkcs7-certificates"},
-    {"p7c", "application/pkcs7-mime"},
-    {"aw", "application/applixware"},
-    {"ink", "application/inkml+xml"},
-    {"nnw", "application/vnd.noblenet-web"},
-    {"curl", "text/vnd.curl"},
-    {"p7m", "application/pkcs7-mime"},
-    {"nns", "application/vnd.noblenet-sealer"},
-    {"uoml", "application/vnd.uoml+xml"},
-    {"grv", "application/vnd.groove-injector"},
-    {"xbm", "image/x-xbitmap"},
-    {"igs", "model/iges"},
-    {"hps", "application/vnd.hp-hps"},
-    {"nb", "application/mathematica"},
-    {"nc", "application/x-netcdf"},
-    {"igx", "application/vnd.micrografx.igx"},
-    {"application", "application/x-ms-application"},
-    {"h261", "video/h261"},
-    {"gre", "application/vnd.geometry-explorer"},
-    {"oas", "application/vnd.fujitsu.oasys"},
-    {"fst", "image/vnd.fst"},
-    {"igm", "application/vnd.insors.igm"},
-    {"igl", "application/vnd.igloader"},
-    {"vrml", "model/vrml"},
-    {"bmi", "application/vnd.bmi"},
-    {"btif", "image/prs.btif"},
-    {"x3d", "model/x3d+xml"},
-    {"ssml", "application/ssml+xml"},
-    {"cb7", "application/x-cbr"},
-    {"sql", "application/x-sql"},
-    {"link66", "application/vnd.route66.link66+xml"},
-    {"au", "audio/basic"},
-    {"fsc", "application/vnd.fsc.weblaunch"},
-    {"dvi", "application/x-dvi"},
-    {"for", "text/x-fortran"},
-    {"ssdl", "application/ssdl+xml"},
-    {"cpt", "application/mac-compactpro"},
-    {"svd", "application/vnd.svd"},
-    {"vcg", "application/vnd.groove-vcard"},
-    {"svc", "application/vnd.dvb.service"},
-    {"portpkg", "application/vnd.macports.portpkg"},
-    {"eol", "audio/vnd.digital-winds"},
-    {"bmp", "image/bmp"},
-    {"iif", "application/vnd.shana.informed.interchange"},
-    {"oa3", "application/vnd.fujitsu.oasys3"},
-    {"oa2", "application/vnd.fujitsu.oasys2"},
-    {"eot", "application/vnd.ms-fontobject"},
-    {"onetoc", "application/onenote"},
-    {"xbd", "application/vnd.fujixerox.docuworks.binder"},
-    {"mrc", "application/marc"},
-    {"sbml", "application/sbml+xml"},
-    {"m2v", "video/mpeg"}};
+/* Generated by tools/mime_types/process.py from mime_types.txt, do not edit.
+ * A perfect hash over the extensions: lookups are case insensitive, allocate nothing, and the tables
+ * are constants, so nothing runs at startup.
+ */
+namespace mime_types {
+struct entry {
+    const char *extension;
+    std::size_t extension_size;
+    const char *type;
+};
+
+constexpr std::size_t bucket_count = 245;
+constexpr std::size_t slot_count = 1227;
+
+constexpr std::uint16_t seeds[bucket_count] = {
+    4, 39, 2, 10, 35, 11, 6, 5, 4, 8, 3, 1, 24, 1, 7, 2,
+    3, 10, 1, 3, 1, 4, 1, 15, 2, 9, 2, 21, 9, 52, 2, 19,
+    3, 3, 1, 80, 4, 4, 29, 26, 8, 20, 13, 8, 11, 7, 2, 16,
+    25, 10, 5, 1, 16, 4, 2, 4, 1, 3, 4, 1, 32, 68, 4, 7,
+    24, 15, 1, 53, 10, 2, 12, 1, 18, 1, 23, 3, 21, 15, 1, 13,
+    25, 1, 22, 30, 8, 9, 27, 15, 18, 9, 22, 1, 51, 0, 2, 12,
+    11, 14, 2, 1, 5, 2, 42, 68, 3, 2, 11, 15, 25, 0, 22, 1,
+    1, 73, 12, 3, 7, 54, 1, 5, 9, 15, 72, 7, 46, 19, 2, 65,
+    14, 36, 24, 8, 14, 35, 2, 22, 33, 25, 0, 9, 7, 6, 31, 13,
+    13, 34, 3, 1, 27, 10, 2, 10, 34, 1, 3, 73, 32, 3, 1, 2,
+    35, 27, 23, 42, 36, 33, 18, 1, 1, 20, 6, 25, 15, 4, 43, 12,
+    1, 66, 58, 2, 5, 9, 13, 3, 68, 94, 1, 1, 1, 16, 2, 70,
+    4, 18, 60, 6, 0, 3, 6, 60, 24, 54, 35, 14, 28, 1, 31, 4,
+    14, 3, 11, 3, 11, 11, 25, 29, 3, 5, 110, 21, 14, 6, 58, 10,
+    29, 20, 6, 48, 3, 18, 1, 14, 32, 6, 1, 62, 50, 36, 2, 11,
+    57, 27, 31, 2, 2,
+};
+
+constexpr entry slots[slot_count] = {
+    {"rp9", 3, "application/vnd.cloanto.rp9"},
+    {"dtb", 3, "application/x-dtbook+xml"},
+    {"class", 5, "application/java-vm"},
+    {"ssf", 3, "application/vnd.epson.ssf"},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"atx", 3, "application/vnd.antix.game-component"},
+    {"ifm", 3, "application/vnd.shana.informed.formdata"},
+    {"ait", 3, "application/vnd.dvb.ait"},
+    {"cbt", 3, "application/x-cbr"},
+    {"uvv", 3, "video/vnd.dece.video"},
+    {"for", 3, "text/x-fortran"},
+    {"epub", 4, "application/epub+zip"},
+    {"swa", 3, "application/x-director"},
+    {"dvi", 3, "application/x-dvi"},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"tsd", 3, "application/timestamped-data"},
+    {"", 0, nullptr},
+    {"uva", 3, "audio/vnd.dece.audio"},
+    {"clkw", 4, "application/vnd.crick.clicker.wordbank"},
+    {"bz", 2, "application/x-bzip"},
+    {"jlt", 3, "application/vnd.hp-jlyt"},
+    {"", 0, nullptr},
+    {"rsd", 3, "application/rsd+xml"},
+    {"uvvd", 4, "application/vnd.dece.data"},
+    {"fhc", 3, "image/x-freehand"},
+    {"fh5", 3, "image/x-freehand"},
+    {"pgp", 3, "application/pgp-encrypted"},
+    {"rq", 2, "application/sparql-query"},
+    {"mbox", 4, "application/mbox"},
+    {"", 0, nullptr},
+    {"tpt", 3, "application/vnd.trid.tpt"},
+    {"xltx", 4, "application/vnd.openxmlformats-officedocument.spreadsheetml.template"},
+    {"x3db", 4, "model/x3d+binary"},
+    {"skp", 3, "application/vnd.koan"},
+    {"gam", 3, "application/x-tads"},
+    {"cdmic", 5, "application/cdmi-container"},
+    {"", 0, nullptr},
+    {"snf", 3, "application/x-font-snf"},
+    {"", 0, nullptr},
+    {"vor", 3, "application/vnd.stardivision.writer"},
+    {"mgp", 3, "application/vnd.osgeo.mapguide.package"},
+    {"spot", 4, "text/vnd.in3d.spot"},
+    {"bmp", 3, "image/bmp"},
+    {"wmlc", 4, "application/vnd.wap.wmlc"},
+    {"ccxml", 5, "application/ccxml+xml"},
+    {"link66", 6, "application/vnd.route66.link66+xml"},
+    {"z7", 2, "application/x-zmachine"},
+    {"mag", 3, "application/vnd.ecowin.chart"},
+    {"gif", 3, "image/gif"},
+    {"mpkg", 4, "application/vnd.apple.installer+xml"},
+    {"xer", 3, "application/patch-ops-error+xml"},
+    {"", 0, nullptr},
+    {"xyz", 3, "chemical/x-xyz"},
+    {"", 0, nullptr},
+    {"uvi", 3, "image/vnd.dece.graphic"},
+    {"gml", 3, "application/gml+xml"},
+    {"shar", 4, "application/x-shar"},
+    {"psf", 3, "application/x-font-linux-psf"},
+    {"ssml", 4, "application/ssml+xml"},
+    {"i2g", 3, "application/vnd.intergeo"},
+    {"acutc", 5, "application/vnd.acucorp"},
+    {"sxd", 3, "application/vnd.sun.xml.draw"},
+    {"gca", 3, "application/x-gca-compressed"},
+    {"tga", 3, "image/x-tga"},
+    {"onetoc2", 7, "application/onenote"},
+    {"", 0, nullptr},
+    {"nlu", 3, "application/vnd.neurolanguage.nlu"},
+    {"", 0, nullptr},
+    {"nns", 3, "application/vnd.noblenet-sealer"},
+    {"pptx", 4, "application/vnd.openxmlformats-officedocument.presentationml.presentation"},
+    {"exe", 3, "application/x-msdownload"},
+    {"tpl", 3, "application/vnd.groove-tool-template"},
+    {"sql", 3, "application/x-sql"},
+    {"", 0, nullptr},
+    {"wad", 3, "application/x-doom"},
+    {"pcl", 3, "application/vnd.hp-pcl"},
+    {"uvvs", 4, "video/vnd.dece.sd"},
+    {"iif", 3, "application/vnd.shana.informed.interchange"},
+    {"svd", 3, "application/vnd.svd"},
+    {"arc", 3, "application/x-freearc"},
+    {"odb", 3, "application/vnd.oasis.opendocument.database"},
+    {"cat", 3, "application/vnd.ms-pki.seccat"},
+    {"", 0, nullptr},
+    {"pml", 3, "application/vnd.ctc-posml"},
+    {"eol", 3, "audio/vnd.digital-winds"},
+    {"ms", 2, "text/troff"},
+    {"wvx", 3, "video/x-ms-wvx"},
+    {"fdf", 3, "application/vnd.fdf"},
+    {"meta4", 5, "application/metalink4+xml"},
+    {"yin", 3, "application/yin+xml"},
+    {"sdd", 3, "application/vnd.stardivision.impress"},
+    {"pkg", 3, "application/octet-stream"},
+    {"iges", 4, "model/iges"},
+    {"sh", 2, "application/x-sh"},
+    {"ktx", 3, "image/ktx"},
+    {"str", 3, "application/vnd.pg.format"},
+    {"ser", 3, "application/java-serialized-object"},
+    {"xlm", 3, "application/vnd.ms-excel"},
+    {"daf", 3, "application/vnd.mobius.daf"},
+    {"kpr", 3, "application/vnd.kde.kpresenter"},
+    {"xml", 3, "application/xml"},
+    {"c11amc", 6, "application/vnd.cluetrust.cartomobile-config"},
+    {"elc", 3, "application/octet-stream"},
+    {"w3d", 3, "application/x-director"},
+    {"", 0, nullptr},
+    {"dp", 2, "application/vnd.osgi.dp"},
+    {"rep", 3, "application/vnd.businessobjects"},
+    {"dll", 3, "application/x-msdownload"},
+    {"bh2", 3, "application/vnd.fujitsu.oasysprs"},
+    {"", 0, nullptr},
+    {"lbd", 3, "application/vnd.llamagraphics.life-balance.desktop"},
+    {"svc", 3, "application/vnd.dvb.service"},
+    {"clp", 3, "application/x-msclip"},
+    {"stw", 3, "application/vnd.sun.xml.writer.template"},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"pcurl", 5, "application/vnd.curl.pcurl"},
+    {"setreg", 6, "application/set-registration-initiation"},
+    {"gdl", 3, "model/vnd.gdl"},
+    {"xdm", 3, "application/vnd.syncml.dm+xml"},
+    {"csp", 3, "application/vnd.commonspace"},
+    {"gph", 3, "application/vnd.flographit"},
+    {"", 0, nullptr},
+    {"es3", 3, "application/vnd.eszigno3+xml"},
+    {"wpd", 3, "application/vnd.wordperfect"},
+    {"", 0, nullptr},
+    {"conf", 4, "text/plain"},
+    {"dts", 3, "audio/vnd.dts"},
+    {"", 0, nullptr},
+    {"sus", 3, "application/vnd.sus-calendar"},
+    {"", 0, nullptr},
+    {"fcdt", 4, "application/vnd.adobe.formscentral.fcdt"},
+    {"qxt", 3, "application/vnd.quark.quarkxpress"},
+    {"uvg", 3, "image/vnd.dece.graphic"},
+    {"dra", 3, "audio/vnd.dra"},
+    {"gqs", 3, "application/vnd.grafeq"},
+    {"mar", 3, "application/octet-stream"},
+    {"jpg", 3, "image/jpeg"},
+    {"tex", 3, "application/x-tex"},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"ggb", 3, "application/vnd.geogebra.file"},
+    {"dxr", 3, "application/x-director"},
+    {"", 0, nullptr},
+    {"bat", 3, "application/x-msdownload"},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"mj2", 3, "video/mj2"},
+    {"", 0, nullptr},
+    {"irm", 3, "application/vnd.ibm.rights-management"},
+    {"st", 2, "application/vnd.sailingtracker.track"},
+    {"emz", 3, "application/x-msmetafile"},
+    {"oa3", 3, "application/vnd.fujitsu.oasys3"},
+    {"", 0, nullptr},
+    {"ez", 2, "application/andrew-inset"},
+    {"def", 3, "text/plain"},
+    {"xo", 2, "application/vnd.olpc-sugar"},
+    {"skd", 3, "application/vnd.koan"},
+    {"uvvz", 4, "application/vnd.dece.zip"},
+    {"xvm", 3, "application/xv+xml"},
+    {"snd", 3, "audio/basic"},
+    {"hvd", 3, "application/vnd.yamaha.hv-dic"},
+    {"sisx", 4, "application/vnd.symbian.install"},
+    {"spx", 3, "audio/ogg"},
+    {"sru", 3, "application/sru+xml"},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"roff", 4, "text/troff"},
+    {"igm", 3, "application/vnd.insors.igm"},
+    {"zirz", 4, "application/vnd.zul"},
+    {"xif", 3, "image/vnd.xiff"},
+    {"texinfo", 7, "application/x-texinfo"},
+    {"mmd", 3, "application/vnd.chipnuts.karaoke-mmd"},
+    {"", 0, nullptr},
+    {"scs", 3, "application/scvp-cv-response"},
+    {"", 0, nullptr},
+    {"f", 1, "text/x-fortran"},
+    {"oda", 3, "application/oda"},
+    {"mpc", 3, "application/vnd.mophun.certificate"},
+    {"mdb", 3, "application/x-msaccess"},
+    {"cmx", 3, "image/x-cmx"},
+    {"mka", 3, "audio/x-matroska"},
+    {"xar", 3, "application/vnd.xara"},
+    {"m3a", 3, "audio/mpeg"},
+    {"u32", 3, "application/x-authorware-bin"},
+    {"wbs", 3, "application/vnd.criticaltools.wbs+xml"},
+    {"pdf", 3, "application/pdf"},
+    {"docx", 4, "application/vnd.openxmlformats-officedocument.wordprocessingml.document"},
+    {"dpg", 3, "application/vnd.dpgraph"},
+    {"irp", 3, "application/vnd.irepository.package+xml"},
+    {"sse", 3, "application/vnd.kodak-descriptor"},
+    {"ice", 3, "x-conference/x-cooltalk"},
+    {"icm", 3, "application/vnd.iccprofile"},
+    {"me", 2, "text/troff"},
+    {"ink", 3, "application/inkml+xml"},
+    {"x32", 3, "application/x-authorware-bin"},
+    {"mts", 3, "model/vnd.mts"},
+    {"", 0, nullptr},
+    {"urls", 4, "text/uri-list"},
+    {"clkk", 4, "application/vnd.crick.clicker.keyboard"},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"atomcat", 7, "application/atomcat+xml"},
+    {"ac", 2, "application/pkix-attr-cert"},
+    {"", 0, nullptr},
+    {"pskcxml", 7, "application/pskc+xml"},
+    {"uvs", 3, "video/vnd.dece.sd"},
+    {"jpe", 3, "image/jpeg"},
+    {"clkx", 4, "application/vnd.crick.clicker"},
+    {"prf", 3, "application/pics-rules"},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"mxml", 4, "application/xv+xml"},
+    {"bdm", 3, "application/vnd.syncml.dm+wbxml"},
+    {"qxl", 3, "application/vnd.quark.quarkxpress"},
+    {"sit", 3, "application/x-stuffit"},
+    {"ecelp9600", 9, "audio/vnd.nuera.ecelp9600"},
+    {"f4v", 3, "video/x-f4v"},
+    {"", 0, nullptr},
+    {"mcurl", 5, "text/vnd.curl.mcurl"},
+    {"rdz", 3, "application/vnd.data-vision.rdz"},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"adp", 3, "audio/adpcm"},
+    {"semf", 4, "application/vnd.semf"},
+    {"igs", 3, "model/iges"},
+    {"xhtml", 5, "application/xhtml+xml"},
+    {"asx", 3, "video/x-ms-asf"},
+    {"kar", 3, "audio/midi"},
+    {"sc", 2, "application/vnd.ibm.secure-container"},
+    {"mxl", 3, "application/vnd.recordare.musicxml"},
+    {"webp", 4, "image/webp"},
+    {"h264", 4, "video/h264"},
+    {"apr", 3, "application/vnd.lotus-approach"},
+    {"uris", 4, "text/uri-list"},
+    {"", 0, nullptr},
+    {"xop", 3, "application/xop+xml"},
+    {"bmi", 3, "application/vnd.bmi"},
+    {"oti", 3, "application/vnd.oasis.opendocument.image-template"},
+    {"lrf", 3, "application/octet-stream"},
+    {"", 0, nullptr},
+    {"ext", 3, "application/vnd.novadigm.ext"},
+    {"fst", 3, "image/vnd.fst"},
+    {"gpx", 3, "application/gpx+xml"},
+    {"srx", 3, "application/sparql-results+xml"},
+    {"cdmio", 5, "application/cdmi-object"},
+    {"kpxx", 4, "application/vnd.ds-keypoint"},
+    {"boz", 3, "application/x-bzip2"},
+    {"car", 3, "application/vnd.curl.car"},
+    {"dot", 3, "application/msword"},
+    {"eml", 3, "message/rfc822"},
+    {"rms", 3, "application/vnd.jcp.javame.midlet-rms"},
+    {"pclxl", 5, "application/vnd.hp-pclxl"},
+    {"swi", 3, "application/vnd.aristanetworks.swi"},
+    {"", 0, nullptr},
+    {"cdx", 3, "chemical/x-cdx"},
+    {"uvvu", 4, "video/vnd.uvvu.mp4"},
+    {"", 0, nullptr},
+    {"uvvv", 4, "video/vnd.dece.video"},
+    {"", 0, nullptr},
+    {"nml", 3, "application/vnd.enliven"},
+    {"tar", 3, "application/x-tar"},
+    {"wspolicy", 8, "application/wspolicy+xml"},
+    {"xls", 3, "application/vnd.ms-excel"},
+    {"knp", 3, "application/vnd.kinar"},
+    {"midi", 4, "audio/midi"},
+    {"", 0, nullptr},
+    {"mxs", 3, "application/vnd.triscape.mxs"},
+    {"", 0, nullptr},
+    {"rmi", 3, "audio/midi"},
+    {"aso", 3, "application/vnd.accpac.simply.aso"},
+    {"iso", 3, "application/x-iso9660-image"},
+    {"", 0, nullptr},
+    {"wmv", 3, "video/x-ms-wmv"},
+    {"ddd", 3, "application/vnd.fujixerox.ddd"},
+    {"vtu", 3, "model/vnd.vtu"},
+    {"", 0, nullptr},
+    {"emf", 3, "application/x-msmetafile"},
+    {"aw", 2, "application/applixware"},
+    {"mpt", 3, "application/vnd.ms-project"},
+    {"unityweb", 8, "application/vnd.unity"},
+    {"mqy", 3, "application/vnd.mobius.mqy"},
+    {"xlf", 3, "application/x-xliff+xml"},
+    {"mmf", 3, "application/vnd.smaf"},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"otp", 3, "application/vnd.oasis.opendocument.presentation-template"},
+    {"shf", 3, "application/shf+xml"},
+    {"p10", 3, "application/pkcs10"},
+    {"ra", 2, "audio/x-pn-realaudio"},
+    {"dd2", 3, "application/vnd.oma.dd2+xml"},
+    {"dir", 3, "application/x-director"},
+    {"davmount", 8, "application/davmount+xml"},
+    {"gex", 3, "application/vnd.geometry-explorer"},
+    {"mk3d", 4, "video/x-matroska"},
+    {"uvvx", 4, "application/vnd.dece.unspecified"},
+    {"", 0, nullptr},
+    {"xpm", 3, "image/x-xpixmap"},
+    {"nc", 2, "application/x-netcdf"},
+    {"obj", 3, "application/x-tgif"},
+    {"itp", 3, "application/vnd.shana.informed.formtemplate"},
+    {"csml", 4, "chemical/x-csml"},
+    {"3gp", 3, "video/3gpp"},
+    {"mc1", 3, "application/vnd.medcalcdata"},
+    {"rdf", 3, "application/rdf+xml"},
+    {"qxb", 3, "application/vnd.quark.quarkxpress"},
+    {"gramps", 6, "application/x-gramps-xml"},
+    {"n3", 2, "text/n3"},
+    {"acu", 3, "application/vnd.acucobol"},
+    {"uri", 3, "text/uri-list"},
+    {"ttc", 3, "application/x-font-ttf"},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"uvm", 3, "video/vnd.dece.mobile"},
+    {"der", 3, "application/x-x509-ca-cert"},
+    {"iota", 4, "application/vnd.astraea-software.iota"},
+    {"rm", 2, "application/vnd.rn-realmedia"},
+    {"cba", 3, "application/x-cbr"},
+    {"cmc", 3, "application/vnd.cosmocaller"},
+    {"xpx", 3, "application/vnd.intercon.formnet"},
+    {"flw", 3, "application/vnd.kde.kivio"},
+    {"g2w", 3, "application/vnd.geoplan"},
+    {"crd", 3, "application/x-mscardfile"},
+    {"sid", 3, "image/x-mrsid-image"},
+    {"cbr", 3, "application/x-cbr"},
+    {"mpp", 3, "application/vnd.ms-project"},
+    {"wtb", 3, "application/vnd.webturbo"},
+    {"latex", 5, "application/x-latex"},
+    {"ps", 2, "application/postscript"},
+    {"mxf", 3, "application/mxf"},
+    {"rcprofile", 9, "application/vnd.ipunplugged.rcprofile"},
+    {"", 0, nullptr},
+    {"xht", 3, "application/xhtml+xml"},
+    {"p7c", 3, "application/pkcs7-mime"},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"uvt", 3, "application/vnd.dece.ttml+xml"},
+    {"", 0, nullptr},
+    {"uvvp", 4, "video/vnd.dece.pd"},
+    {"json", 4, "application/json"},
+    {"stl", 3, "application/vnd.ms-pki.stl"},
+    {"", 0, nullptr},
+    {"cap", 3, "application/vnd.tcpdump.pcap"},
+    {"ppsm", 4, "application/vnd.ms-powerpoint.slideshow.macroenabled.12"},
+    {"mpe", 3, "video/mpeg"},
+    {"gxf", 3, "application/gxf"},
+    {"s3m", 3, "audio/s3m"},
+    {"", 0, nullptr},
+    {"qam", 3, "application/vnd.epson.quickanime"},
+    {"cct", 3, "application/x-director"},
+    {"dcurl", 5, "text/vnd.curl.dcurl"},
+    {"ecelp4800", 9, "audio/vnd.nuera.ecelp4800"},
+    {"hpgl", 4, "application/vnd.hp-hpgl"},
+    {"scd", 3, "application/x-msschedule"},
+    {"ttf", 3, "application/x-font-ttf"},
+    {"rif", 3, "application/reginfo+xml"},
+    {"", 0, nullptr},
+    {"fxp", 3, "application/vnd.adobe.fxp"},
+    {"pvb", 3, "application/vnd.3gpp.pic-bw-var"},
+    {"", 0, nullptr},
+    {"gim", 3, "application/vnd.groove-identity-message"},
+    {"ppm", 3, "image/x-portable-pixmap"},
+    {"", 0, nullptr},
+    {"uu", 2, "text/x-uuencode"},
+    {"jpgv", 4, "video/jpeg"},
+    {"xz", 2, "application/x-xz"},
+    {"opml", 4, "text/x-opml"},
+    {"otc", 3, "application/vnd.oasis.opendocument.chart-template"},
+    {"", 0, nullptr},
+    {"et3", 3, "application/vnd.eszigno3+xml"},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"wps", 3, "application/vnd.ms-works"},
+    {"wqd", 3, "application/vnd.wqd"},
+    {"", 0, nullptr},
+    {"jpgm", 4, "video/jpm"},
+    {"", 0, nullptr},
+    {"uvu", 3, "video/vnd.uvvu.mp4"},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"jpeg", 4, "image/jpeg"},
+    {"tsv", 3, "text/tab-separated-values"},
+    {"texi", 4, "application/x-texinfo"},
+    {"azf", 3, "application/vnd.airzip.filesecure.azf"},
+    {"ogv", 3, "video/ogg"},
+    {"ods", 3, "application/vnd.oasis.opendocument.spreadsheet"},
+    {"", 0, nullptr},
+    {"aab", 3, "application/x-authorware-bin"},
+    {"xul", 3, "application/vnd.mozilla.xul+xml"},
+    {"asc", 3, "application/pgp-signature"},
+    {"odf", 3, "application/vnd.oasis.opendocument.formula"},
+    {"odg", 3, "application/vnd.oasis.opendocument.graphics"},
+    {"fzs", 3, "application/vnd.fuzzysheet"},
+    {"dms", 3, "application/octet-stream"},
+    {"flv", 3, "video/x-flv"},
+    {"mscml", 5, "application/mediaservercontrol+xml"},
+    {"geo", 3, "application/vnd.dynageo"},
+    {"cww", 3, "application/prs.cww"},
+    {"m3u8", 4, "application/vnd.apple.mpegurl"},
+    {"cb7", 3, "application/x-cbr"},
+    {"hvp", 3, "application/vnd.yamaha.hv-voice"},
+    {"", 0, nullptr},
+    {"sti", 3, "application/vnd.sun.xml.impress.template"},
+    {"fti", 3, "application/vnd.anser-web-funds-transfer-initiation"},
+    {"x3dvz", 5, "model/x3d+vrml"},
+    {"uvh", 3, "video/vnd.dece.hd"},
+    {"fh7", 3, "image/x-freehand"},
+    {"xdp", 3, "application/vnd.adobe.xdp+xml"},
+    {"wmf", 3, "application/x-msmetafile"},
+    {"", 0, nullptr},
+    {"wml", 3, "text/vnd.wap.wml"},
+    {"", 0, nullptr},
+    {"fg5", 3, "application/vnd.fujitsu.oasysgp"},
+    {"", 0, nullptr},
+    {"dcr", 3, "application/x-director"},
+    {"", 0, nullptr},
+    {"xwd", 3, "image/x-xwindowdump"},
+    {"msf", 3, "application/vnd.epson.msf"},
+    {"saf", 3, "application/vnd.yamaha.smaf-audio"},
+    {"tfm", 3, "application/x-tex-tfm"},
+    {"", 0, nullptr},
+    {"ufd", 3, "application/vnd.ufdl"},
+    {"igl", 3, "application/vnd.igloader"},
+    {"mpn", 3, "application/vnd.mophun.application"},
+    {"pct", 3, "image/x-pict"},
+    {"spq", 3, "application/scvp-vp-request"},
+    {"wri", 3, "application/x-mswrite"},
+    {"flo", 3, "application/vnd.micrografx.flo"},
+    {"edx", 3, "application/vnd.novadigm.edx"},
+    {"pfm", 3, "application/x-font-type1"},
+    {"xenc", 4, "application/xenc+xml"},
+    {"", 0, nullptr},
+    {"odp", 3, "application/vnd.oasis.opendocument.presentation"},
+    {"ez2", 3, "application/vnd.ezpix-album"},
+    {"zmm", 3, "application/vnd.handheld-entertainment+xml"},
+    {"potm", 4, "application/vnd.ms-powerpoint.template.macroenabled.12"},
+    {"nnw", 3, "application/vnd.noblenet-web"},
+    {"", 0, nullptr},
+    {"mads", 4, "application/mads+xml"},
+    {"dwg", 3, "image/vnd.dwg"},
+    {"plf", 3, "application/vnd.pocketlearn"},
+    {"mp2a", 4, "audio/mpeg"},
+    {"vxml", 4, "application/voicexml+xml"},
+    {"dna", 3, "application/vnd.dna"},
+    {"vcx", 3, "application/vnd.vcx"},
+    {"ico", 3, "image/x-icon"},
+    {"mobi", 4, "application/x-mobipocket-ebook"},
+    {"aif", 3, "audio/x-aiff"},
+    {"z2", 2, "application/x-zmachine"},
+    {"zip", 3, "application/zip"},
+    {"", 0, nullptr},
+    {"dbk", 3, "application/docbook+xml"},
+    {"cif", 3, "chemical/x-cif"},
+    {"fli", 3, "video/x-fli"},
+    {"", 0, nullptr},
+    {"cmdf", 4, "chemical/x-cmdf"},
+    {"", 0, nullptr},
+    {"xbap", 4, "application/x-ms-xbap"},
+    {"xlsm", 4, "application/vnd.ms-excel.sheet.macroenabled.12"},
+    {"efif", 4, "application/vnd.picsel"},
+    {"application", 11, "application/x-ms-application"},
+    {"msi", 3, "application/x-msdownload"},
+    {"fsc", 3, "application/vnd.fsc.weblaunch"},
+    {"xlc", 3, "application/vnd.ms-excel"},
+    {"", 0, nullptr},
+    {"ots", 3, "application/vnd.oasis.opendocument.spreadsheet-template"},
+    {"odt", 3, "application/vnd.oasis.opendocument.text"},
+    {"png", 3, "image/png"},
+    {"bdf", 3, "application/x-font-bdf"},
+    {"xvml", 4, "application/xv+xml"},
+    {"", 0, nullptr},
+    {"esf", 3, "application/vnd.epson.esf"},
+    {"rmvb", 4, "application/vnd.rn-realmedia-vbr"},
+    {"sis", 3, "application/vnd.symbian.install"},
+    {"djv", 3, "image/vnd.djvu"},
+    {"", 0, nullptr},
+    {"dsc", 3, "text/prs.lines.tag"},
+    {"lvp", 3, "audio/vnd.lucent.voice"},
+    {"crt", 3, "application/x-x509-ca-cert"},
+    {"caf", 3, "audio/x-caf"},
+    {"ptid", 4, "application/vnd.pvi.ptid1"},
+    {"plb", 3, "application/vnd.3gpp.pic-bw-large"},
+    {"smi", 3, "application/smil+xml"},
+    {"", 0, nullptr},
+    {"ivp", 3, "application/vnd.immervision-ivp"},
+    {"webm", 4, "video/webm"},
+    {"sgm", 3, "text/sgml"},
+    {"aiff", 4, "audio/x-aiff"},
+    {"", 0, nullptr},
+    {"wrl", 3, "model/vrml"},
+    {"kia", 3, "application/vnd.kidspiration"},
+    {"pls", 3, "application/pls+xml"},
+    {"atom", 4, "application/atom+xml"},
+    {"afm", 3, "application/x-font-type1"},
+    {"odm", 3, "application/vnd.oasis.opendocument.text-master"},
+    {"fpx", 3, "image/vnd.fpx"},
+    {"", 0, nullptr},
+    {"ipk", 3, "application/vnd.shana.informed.package"},
+    {"vcd", 3, "application/x-cdlink"},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"dtd", 3, "application/xml-dtd"},
+    {"susp", 4, "application/vnd.sus-calendar"},
+    {"mrcx", 4, "application/marcxml+xml"},
+    {"dump", 4, "application/octet-stream"},
+    {"ngdat", 5, "application/vnd.nokia.n-gage.data"},
+    {"cdkey", 5, "application/vnd.mediastation.cdkey"},
+    {"", 0, nullptr},
+    {"pot", 3, "application/vnd.ms-powerpoint"},
+    {"pdb", 3, "application/vnd.palm"},
+    {"p7s", 3, "application/pkcs7-signature"},
+    {"", 0, nullptr},
+    {"lwp", 3, "application/vnd.lotus-wordpro"},
+    {"man", 3, "text/troff"},
+    {"nsc", 3, "application/x-conference"},
+    {"pas", 3, "text/x-pascal"},
+    {"", 0, nullptr},
+    {"prc", 3, "application/x-mobipocket-ebook"},
+    {"z6", 2, "application/x-zmachine"},
+    {"com", 3, "application/x-msdownload"},
+    {"p7r", 3, "application/x-pkcs7-certreqresp"},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"seed", 4, "application/vnd.fdsn.seed"},
+    {"xslt", 4, "application/xslt+xml"},
+    {"", 0, nullptr},
+    {"fe_launch", 9, "application/vnd.denovo.fcselayout-link"},
+    {"lha", 3, "application/x-lzh-compressed"},
+    {"pgm", 3, "image/x-portable-graymap"},
+    {"book", 4, "application/vnd.framemaker"},
+    {"nsf", 3, "application/vnd.lotus-notes"},
+    {"odft", 4, "application/vnd.oasis.opendocument.formula-template"},
+    {"h263", 4, "video/h263"},
+    {"ksp", 3, "application/vnd.kde.kspread"},
+    {"", 0, nullptr},
+    {"wmz", 3, "application/x-msmetafile"},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"clkt", 4, "application/vnd.crick.clicker.template"},
+    {"", 0, nullptr},
+    {"doc", 3, "application/msword"},
+    {"xpw", 3, "application/vnd.intercon.formnet"},
+    {"tcap", 4, "application/vnd.3gpp2.tcap"},
+    {"xpl", 3, "application/xproc+xml"},
+    {"pic", 3, "image/x-pict"},
+    {"oa2", 3, "application/vnd.fujitsu.oasys2"},
+    {"", 0, nullptr},
+    {"wav", 3, "audio/x-wav"},
+    {"mkv", 3, "video/x-matroska"},
+    {"twd", 3, "application/vnd.simtech-mindmapper"},
+    {"cpt", 3, "application/mac-compactpro"},
+    {"weba", 4, "audio/webm"},
+    {"mie", 3, "application/x-mie"},
+    {"", 0, nullptr},
+    {"dssc", 4, "application/dssc+der"},
+    {"eot", 3, "application/vnd.ms-fontobject"},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"docm", 4, "application/vnd.ms-word.document.macroenabled.12"},
+    {"sdp", 3, "application/sdp"},
+    {"", 0, nullptr},
+    {"ras", 3, "image/x-cmu-raster"},
+    {"", 0, nullptr},
+    {"bz2", 3, "application/x-bzip2"},
+    {"afp", 3, "application/vnd.ibm.modcap"},
+    {"pwn", 3, "application/vnd.3m.post-it-notes"},
+    {"", 0, nullptr},
+    {"paw", 3, "application/vnd.pawaafile"},
+    {"edm", 3, "application/vnd.novadigm.edm"},
+    {"vsf", 3, "application/vnd.vsf"},
+    {"cmp", 3, "application/vnd.yellowriver-custom-menu"},
+    {"mp4s", 4, "application/mp4"},
+    {"xaml", 4, "application/xaml+xml"},
+    {"t3", 2, "application/x-t3vm-image"},
+    {"", 0, nullptr},
+    {"ott", 3, "application/vnd.oasis.opendocument.text-template"},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"esa", 3, "application/vnd.osgi.subsystem"},
+    {"", 0, nullptr},
+    {"pyv", 3, "video/vnd.ms-playready.media.pyv"},
+    {"lbe", 3, "application/vnd.llamagraphics.life-balance.exchange+xml"},
+    {"", 0, nullptr},
+    {"xdw", 3, "application/vnd.fujixerox.docuworks"},
+    {"inkml", 5, "application/inkml+xml"},
+    {"xfdf", 4, "application/vnd.adobe.xfdf"},
+    {"", 0, nullptr},
+    {"nzb", 3, "application/x-nzb"},
+    {"cdmia", 5, "application/cdmi-capability"},
+    {"p7b", 3, "application/x-pkcs7-certificates"},
+    {"ecelp7470", 9, "audio/vnd.nuera.ecelp7470"},
+    {"", 0, nullptr},
+    {"fxpl", 4, "application/vnd.adobe.fxp"},
+    {"", 0, nullptr},
+    {"log", 3, "text/plain"},
+    {"djvu", 4, "image/vnd.djvu"},
+    {"", 0, nullptr},
+    {"ppam", 4, "application/vnd.ms-powerpoint.addin.macroenabled.12"},
+    {"mets", 4, "application/mets+xml"},
+    {"mng", 3, "video/x-mng"},
+    {"roa", 3, "application/rpki-roa"},
+    {"m2v", 3, "video/mpeg"},
+    {"mbk", 3, "application/vnd.mobius.mbk"},
+    {"msty", 4, "application/vnd.muvee.style"},
+    {"", 0, nullptr},
+    {"ogg", 3, "audio/ogg"},
+    {"", 0, nullptr},
+    {"wdp", 3, "image/vnd.ms-photo"},
+    {"wks", 3, "application/vnd.ms-works"},
+    {"scurl", 5, "text/vnd.curl.scurl"},
+    {"mseq", 4, "application/vnd.mseq"},
+    {"uvd", 3, "application/vnd.dece.data"},
+    {"rar", 3, "application/x-rar-compressed"},
+    {"rtf", 3, "application/rtf"},
+    {"", 0, nullptr},
+    {"fly", 3, "text/vnd.fly"},
+    {"", 0, nullptr},
+    {"lrm", 3, "application/vnd.ms-lrm"},
+    {"gac", 3, "application/vnd.groove-account"},
+    {"qfx", 3, "application/vnd.intu.qfx"},
+    {"sxi", 3, "application/vnd.sun.xml.impress"},
+    {"csv", 3, "text/csv"},
+    {"ivu", 3, "application/vnd.immervision-ivu"},
+    {"", 0, nullptr},
+    {"t", 1, "text/troff"},
+    {"xm", 2, "audio/xm"},
+    {"cxt", 3, "application/x-director"},
+    {"blorb", 5, "application/x-blorb"},
+    {"sitx", 4, "application/x-stuffitx"},
+    {"mp21", 4, "application/mp21"},
+    {"cdxml", 5, "application/vnd.chemdraw+xml"},
+    {"", 0, nullptr},
+    {"mov", 3, "video/quicktime"},
+    {"", 0, nullptr},
+    {"uoml", 4, "application/vnd.uoml+xml"},
+    {"ncx", 3, "application/x-dtbncx+xml"},
+    {"uvvh", 4, "video/vnd.dece.hd"},
+    {"sfd-hdstx", 9, "application/vnd.hydrostatix.sof-data"},
+    {"sema", 4, "application/vnd.sema"},
+    {"xfdl", 4, "application/vnd.xfdl"},
+    {"kon", 3, "application/vnd.kde.kontour"},
+    {"ktz", 3, "application/vnd.kahootz"},
+    {"fh4", 3, "image/x-freehand"},
+    {"c4u", 3, "application/vnd.clonk.c4group"},
+    {"ipfix", 5, "application/ipfix"},
+    {"", 0, nullptr},
+    {"qwd", 3, "application/vnd.quark.quarkxpress"},
+    {"sdkm", 4, "application/vnd.solent.sdkm+xml"},
+    {"", 0, nullptr},
+    {"hps", 3, "application/vnd.hp-hps"},
+    {"ppsx", 4, "application/vnd.openxmlformats-officedocument.presentationml.slideshow"},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"fcs", 3, "application/vnd.isac.fcs"},
+    {"", 0, nullptr},
+    {"m3u", 3, "audio/x-mpegurl"},
+    {"maker", 5, "application/vnd.framemaker"},
+    {"", 0, nullptr},
+    {"cdmiq", 5, "application/cdmi-queue"},
+    {"src", 3, "application/x-wais-source"},
+    {"pnm", 3, "image/x-portable-anymap"},
+    {"", 0, nullptr},
+    {"dgc", 3, "application/x-dgc-compressed"},
+    {"atc", 3, "application/vnd.acucorp"},
+    {"", 0, nullptr},
+    {"onetmp", 6, "application/onenote"},
+    {"dwf", 3, "model/vnd.dwf"},
+    {"dis", 3, "application/vnd.mobius.dis"},
+    {"spf", 3, "application/vnd.yamaha.smaf-phrase"},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"skt", 3, "application/vnd.koan"},
+    {"", 0, nullptr},
+    {"spc", 3, "application/x-pkcs7-certificates"},
+    {"cla", 3, "application/vnd.claymore"},
+    {"msl", 3, "application/vnd.mobius.msl"},
+    {"", 0, nullptr},
+    {"sfs", 3, "application/vnd.spotfire.sfs"},
+    {"in", 2, "text/plain"},
+    {"taglet", 6, "application/vnd.mynfc"},
+    {"jisp", 4, "application/vnd.jisp"},
+    {"uvvg", 4, "image/vnd.dece.graphic"},
+    {"", 0, nullptr},
+    {"trm", 3, "application/x-msterminal"},
+    {"res", 3, "application/x-dtbresource+xml"},
+    {"", 0, nullptr},
+    {"pfb", 3, "application/x-font-type1"},
+    {"emma", 4, "application/emma+xml"},
+    {"sldx", 4, "application/vnd.openxmlformats-officedocument.presentationml.slide"},
+    {"hh", 2, "text/x-c"},
+    {"zir", 3, "application/vnd.zul"},
+    {"", 0, nullptr},
+    {"rl", 2, "application/resource-lists+xml"},
+    {"frame", 5, "application/vnd.framemaker"},
+    {"", 0, nullptr},
+    {"dist", 4, "application/octet-stream"},
+    {"qxd", 3, "application/vnd.quark.quarkxpress"},
+    {"fvt", 3, "video/vnd.fvt"},
+    {"install", 7, "application/x-install-instructions"},
+    {"", 0, nullptr},
+    {"rld", 3, "application/resource-lists-diff+xml"},
+    {"dic", 3, "text/x-c"},
+    {"", 0, nullptr},
+    {"uvvf", 4, "application/vnd.dece.data"},
+    {"mp4v", 4, "video/mp4"},
+    {"", 0, nullptr},
+    {"cgm", 3, "image/cgm"},
+    {"ecma", 4, "application/ecmascript"},
+    {"grv", 3, "application/vnd.groove-injector"},
+    {"uvx", 3, "application/vnd.dece.unspecified"},
+    {"deploy", 6, "application/octet-stream"},
+    {"grxml", 5, "application/srgs+xml"},
+    {"gtw", 3, "model/vnd.gtw"},
+    {"mlp", 3, "application/vnd.dolby.mlp"},
+    {"eps", 3, "application/postscript"},
+    {"", 0, nullptr},
+    {"x3dz", 4, "model/x3d+xml"},
+    {"", 0, nullptr},
+    {"viv", 3, "video/vnd.vivo"},
+    {"", 0, nullptr},
+    {"mjp2", 4, "video/mj2"},
+    {"setpay", 6, "application/set-payment-initiation"},
+    {"x3d", 3, "model/x3d+xml"},
+    {"lzh", 3, "application/x-lzh-compressed"},
+    {"dxp", 3, "application/vnd.spotfire.dxp"},
+    {"curl", 4, "text/vnd.curl"},
+    {"dae", 3, "model/vnd.collada+xml"},
+    {"qt", 2, "video/quicktime"},
+    {"sv4crc", 6, "application/x-sv4crc"},
+    {"csh", 3, "application/x-csh"},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"svg", 3, "image/svg+xml"},
+    {"gtm", 3, "application/vnd.groove-tool-message"},
+    {"p8", 2, "application/pkcs8"},
+    {"atomsvc", 7, "application/atomsvc+xml"},
+    {"z3", 2, "application/x-zmachine"},
+    {"cab", 3, "application/vnd.ms-cab-compressed"},
+    {"lostxml", 7, "application/lost+xml"},
+    {"ltf", 3, "application/vnd.frogans.ltf"},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"org", 3, "application/vnd.lotus-organizer"},
+    {"musicxml", 8, "application/vnd.recordare.musicxml+xml"},
+    {"wcm", 3, "application/vnd.ms-works"},
+    {"tao", 3, "application/vnd.tao.intent-module-archive"},
+    {"nbp", 3, "application/vnd.wolfram.player"},
+    {"dvb", 3, "video/vnd.dvb.file"},
+    {"", 0, nullptr},
+    {"ace", 3, "application/x-ace-compressed"},
+    {"ulx", 3, "application/x-glulx"},
+    {"cil", 3, "application/vnd.ms-artgalry"},
+    {"omdoc", 5, "application/omdoc+xml"},
+    {"", 0, nullptr},
+    {"dmp", 3, "application/vnd.tcpdump.pcap"},
+    {"gre", 3, "application/vnd.geometry-explorer"},
+    {"pfr", 3, "application/font-tdpfr"},
+    {"yang", 4, "application/yang"},
+    {"vcs", 3, "text/x-vcalendar"},
+    {"kfo", 3, "application/vnd.kde.kformula"},
+    {"", 0, nullptr},
+    {"htm", 3, "text/html"},
+    {"aam", 3, "application/x-authorware-map"},
+    {"mseed", 5, "application/vnd.fdsn.mseed"},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"gxt", 3, "application/vnd.geonext"},
+    {"p7m", 3, "application/pkcs7-mime"},
+    {"fnc", 3, "application/vnd.frogans.fnc"},
+    {"", 0, nullptr},
+    {"sgl", 3, "application/vnd.stardivision.writer-global"},
+    {"nnd", 3, "application/vnd.noblenet-directory"},
+    {"mp3", 3, "audio/mpeg"},
+    {"cii", 3, "application/vnd.anser-web-certificate-issue-initiation"},
+    {"mb", 2, "application/mathematica"},
+    {"pfa", 3, "application/x-font-type1"},
+    {"spl", 3, "application/x-futuresplash"},
+    {"stc", 3, "application/vnd.sun.xml.calc.template"},
+    {"appcache", 8, "text/cache-manifest"},
+    {"cst", 3, "application/x-director"},
+    {"m21", 3, "application/mp21"},
+    {"c4f", 3, "application/vnd.clonk.c4group"},
+    {"xla", 3, "application/vnd.ms-excel"},
+    {"mods", 4, "application/mods+xml"},
+    {"pgn", 3, "application/x-chess-pgn"},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"dmg", 3, "application/x-apple-diskimage"},
+    {"wmlsc", 5, "application/vnd.wap.wmlscriptc"},
+    {"apk", 3, "application/vnd.android.package-archive"},
+    {"cu", 2, "application/cu-seeme"},
+    {"air", 3, "application/vnd.adobe.air-application-installer-package+zip"},
+    {"clkp", 4, "application/vnd.crick.clicker.palette"},
+    {"", 0, nullptr},
+    {"cdmid", 5, "application/cdmi-domain"},
+    {"mpm", 3, "application/vnd.blueice.multipass"},
+    {"oga", 3, "audio/ogg"},
+    {"c11amz", 6, "application/vnd.cluetrust.cartomobile-config-pkg"},
+    {"", 0, nullptr},
+    {"xpr", 3, "application/vnd.is-xpr"},
+    {"cdy", 3, "application/vnd.cinderella"},
+    {"wsdl", 4, "application/wsdl+xml"},
+    {"x3dv", 4, "model/x3d+vrml"},
+    {"xlam", 4, "application/vnd.ms-excel.addin.macroenabled.12"},
+    {"gnumeric", 8, "application/x-gnumeric"},
+    {"tr", 2, "text/troff"},
+    {"mmr", 3, "image/vnd.fujixerox.edmics-mmr"},
+    {"jar", 3, "application/java-archive"},
+    {"ktr", 3, "application/vnd.kahootz"},
+    {"thmx", 4, "application/vnd.ms-officetheme"},
+    {"3ds", 3, "image/x-3ds"},
+    {"", 0, nullptr},
+    {"dfac", 4, "application/vnd.dreamfactory"},
+    {"", 0, nullptr},
+    {"m13", 3, "application/x-msmediaview"},
+    {"pcf", 3, "application/x-font-pcf"},
+    {"oth", 3, "application/vnd.oasis.opendocument.text-web"},
+    {"list", 4, "text/plain"},
+    {"s", 1, "text/x-asm"},
+    {"chm", 3, "application/vnd.ms-htmlhelp"},
+    {"bed", 3, "application/vnd.realvnc.bed"},
+    {"mpeg", 4, "video/mpeg"},
+    {"tfi", 3, "application/thraud+xml"},
+    {"bpk", 3, "application/octet-stream"},
+    {"z4", 2, "application/x-zmachine"},
+    {"f77", 3, "text/x-fortran"},
+    {"", 0, nullptr},
+    {"mp4", 3, "video/mp4"},
+    {"", 0, nullptr},
+    {"3dml", 4, "text/vnd.in3d.3dml"},
+    {"mft", 3, "application/rpki-manifest"},
+    {"slt", 3, "application/vnd.epson.salt"},
+    {"zaz", 3, "application/vnd.zzazz.deck+xml"},
+    {"", 0, nullptr},
+    {"tiff", 4, "image/tiff"},
+    {"oas", 3, "application/vnd.fujitsu.oasys"},
+    {"au", 2, "audio/basic"},
+    {"mime", 4, "message/rfc822"},
+    {"tif", 3, "image/tiff"},
+    {"pya", 3, "audio/vnd.ms-playready.media.pya"},
+    {"mp2", 3, "audio/mpeg"},
+    {"xdf", 3, "application/xcap-diff+xml"},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"tmo", 3, "application/vnd.tmobile-livetv"},
+    {"f90", 3, "text/x-fortran"},
+    {"ghf", 3, "application/vnd.groove-help"},
+    {"movie", 5, "video/x-sgi-movie"},
+    {"hqx", 3, "application/mac-binhex40"},
+    {"dtshd", 5, "audio/vnd.dts.hd"},
+    {"cod", 3, "application/vnd.rim.cod"},
+    {"mpg", 3, "video/mpeg"},
+    {"", 0, nullptr},
+    {"fh", 2, "image/x-freehand"},
+    {"", 0, nullptr},
+    {"qbo", 3, "application/vnd.intu.qbo"},
+    {"nb", 2, "application/mathematica"},
+    {"html", 4, "text/html"},
+    {"cryptonote", 10, "application/vnd.rig.cryptonote"},
+    {"pre", 3, "application/vnd.lotus-freelance"},
+    {"mny", 3, "application/x-msmoney"},
+    {"asm", 3, "text/x-asm"},
+    {"pcap", 4, "application/vnd.tcpdump.pcap"},
+    {"m4u", 3, "video/vnd.mpegurl"},
+    {"sxc", 3, "application/vnd.sun.xml.calc"},
+    {"", 0, nullptr},
+    {"xap", 3, "application/x-silverlight-app"},
+    {"list3820", 8, "application/vnd.ibm.modcap"},
+    {"obd", 3, "application/x-msbinder"},
+    {"wax", 3, "audio/x-ms-wax"},
+    {"", 0, nullptr},
+    {"qwt", 3, "application/vnd.quark.quarkxpress"},
+    {"pfx", 3, "application/x-pkcs12"},
+    {"imp", 3, "application/vnd.accpac.simply.imp"},
+    {"sda", 3, "application/vnd.stardivision.draw"},
+    {"sxg", 3, "application/vnd.sun.xml.writer.global"},
+    {"", 0, nullptr},
+    {"dotx", 4, "application/vnd.openxmlformats-officedocument.wordprocessingml.template"},
+    {"", 0, nullptr},
+    {"smil", 4, "application/smil+xml"},
+    {"m14", 3, "application/x-msmediaview"},
+    {"mxu", 3, "video/vnd.mpegurl"},
+    {"oprc", 4, "application/vnd.palm"},
+    {"ics", 3, "text/calendar"},
+    {"", 0, nullptr},
+    {"sdw", 3, "application/vnd.stardivision.writer"},
+    {"ims", 3, "application/vnd.ms-ims"},
+    {"g3w", 3, "application/vnd.geospace"},
+    {"gmx", 3, "application/vnd.gmx"},
+    {"cxx", 3, "text/x-c"},
+    {"xspf", 4, "application/xspf+xml"},
+    {"vis", 3, "application/vnd.visionary"},
+    {"hbci", 4, "application/vnd.hbci"},
+    {"dotm", 4, "application/vnd.ms-word.template.macroenabled.12"},
+    {"", 0, nullptr},
+    {"pkipath", 7, "application/pkix-pkipath"},
+    {"exi", 3, "application/exi"},
+    {"uvvm", 4, "video/vnd.dece.mobile"},
+    {"ief", 3, "image/ief"},
+    {"rgb", 3, "image/x-rgb"},
+    {"fgd", 3, "application/x-director"},
+    {"odc", 3, "application/vnd.oasis.opendocument.chart"},
+    {"umj", 3, "application/vnd.umajin"},
+    {"xps", 3, "application/vnd.ms-xpsdocument"},
+    {"wdb", 3, "application/vnd.ms-works"},
+    {"pps", 3, "application/vnd.ms-powerpoint"},
+    {"", 0, nullptr},
+    {"h", 1, "text/x-c"},
+    {"xlsb", 4, "application/vnd.ms-excel.sheet.binary.macroenabled.12"},
+    {"sfv", 3, "text/x-sfv"},
+    {"java", 4, "text/x-java-source"},
+    {"z5", 2, "application/x-zmachine"},
+    {"", 0, nullptr},
+    {"pptm", 4, "application/vnd.ms-powerpoint.presentation.macroenabled.12"},
+    {"", 0, nullptr},
+    {"vox", 3, "application/x-authorware-bin"},
+    {"joda", 4, "application/vnd.joost.joda-archive"},
+    {"fig", 3, "application/x-xfig"},
+    {"blb", 3, "application/x-blorb"},
+    {"aac", 3, "audio/x-aac"},
+    {"kne", 3, "application/vnd.kinar"},
+    {"mrc", 3, "application/marc"},
+    {"ei6", 3, "application/vnd.pg.osasli"},
+    {"rlc", 3, "image/vnd.fujixerox.edmics-rlc"},
+    {"sldm", 4, "application/vnd.ms-powerpoint.slide.macroenabled.12"},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"torrent", 7, "application/x-bittorrent"},
+    {"uvp", 3, "video/vnd.dece.pd"},
+    {"", 0, nullptr},
+    {"z8", 2, "application/x-zmachine"},
+    {"c4g", 3, "application/vnd.clonk.c4group"},
+    {"ufdl", 4, "application/vnd.ufdl"},
+    {"mpy", 3, "application/vnd.ibm.minipay"},
+    {"qps", 3, "application/vnd.publishare-delta-tree"},
+    {"xltm", 4, "application/vnd.ms-excel.template.macroenabled.12"},
+    {"", 0, nullptr},
+    {"txd", 3, "application/vnd.genomatix.tuxedo"},
+    {"odi", 3, "application/vnd.oasis.opendocument.image"},
+    {"ttl", 3, "text/turtle"},
+    {"chat", 4, "application/x-chat"},
+    {"abw", 3, "application/x-abiword"},
+    {"sil", 3, "audio/silk"},
+    {"wg", 2, "application/vnd.pmi.widget"},
+    {"sub", 3, "text/vnd.dvb.subtitle"},
+    {"cdbcmsg", 7, "application/vnd.contact.cmsg"},
+    {"wgt", 3, "application/widget"},
+    {"xhvml", 5, "application/xv+xml"},
+    {"osfpvg", 6, "application/vnd.yamaha.openscoreformat.osfpvg+xml"},
+    {"stf", 3, "application/vnd.wt.stf"},
+    {"fm", 2, "application/vnd.framemaker"},
+    {"psb", 3, "application/vnd.3gpp.pic-bw-small"},
+    {"", 0, nullptr},
+    {"silo", 4, "model/mesh"},
+    {"teicorpus", 9, "application/tei+xml"},
+    {"wm", 2, "video/x-ms-wm"},
+    {"7z", 2, "application/x-7z-compressed"},
+    {"", 0, nullptr},
+    {"m2a", 3, "audio/mpeg"},
+    {"msh", 3, "model/mesh"},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"wpl", 3, "application/vnd.ms-wpl"},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"n-gage", 6, "application/vnd.nokia.n-gage.symbian.install"},
+    {"", 0, nullptr},
+    {"tra", 3, "application/vnd.trueapp"},
+    {"", 0, nullptr},
+    {"cfs", 3, "application/x-cfs-compressed"},
+    {"les", 3, "application/vnd.hhe.lesson-player"},
+    {"nitf", 4, "application/vnd.nitf"},
+    {"deb", 3, "application/x-debian-package"},
+    {"ppt", 3, "application/vnd.ms-powerpoint"},
+    {"hal", 3, "application/vnd.hal+xml"},
+    {"mcd", 3, "application/vnd.mcd"},
+    {"evy", 3, "application/x-envoy"},
+    {"", 0, nullptr},
+    {"kml", 3, "application/vnd.google-earth.kml+xml"},
+    {"", 0, nullptr},
+    {"onetoc", 6, "application/onenote"},
+    {"sgml", 4, "text/sgml"},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"dart", 4, "application/vnd.dart"},
+    {"skm", 3, "application/vnd.koan"},
+    {"gqf", 3, "application/vnd.grafeq"},
+    {"etx", 3, "text/x-setext"},
+    {"rmp", 3, "audio/x-pn-realaudio-plugin"},
+    {"portpkg", 7, "application/vnd.macports.portpkg"},
+    {"uvvt", 4, "application/vnd.dece.ttml+xml"},
+    {"scm", 3, "application/vnd.lotus-screencam"},
+    {"", 0, nullptr},
+    {"otf", 3, "application/x-font-otf"},
+    {"mvb", 3, "application/x-msmediaview"},
+    {"rss", 3, "application/rss+xml"},
+    {"kpt", 3, "application/vnd.kde.kpresenter"},
+    {"hdf", 3, "application/x-hdf"},
+    {"ssdl", 4, "application/ssdl+xml"},
+    {"xbd", 3, "application/vnd.fujixerox.docuworks.binder"},
+    {"", 0, nullptr},
+    {"mp4a", 4, "audio/mp4"},
+    {"", 0, nullptr},
+    {"pki", 3, "application/pkixcmp"},
+    {"srt", 3, "application/x-subrip"},
+    {"mpga", 4, "audio/mpeg"},
+    {"xsm", 3, "application/vnd.syncml+xml"},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"gbr", 3, "application/rpki-ghostbusters"},
+    {"swf", 3, "application/x-shockwave-flash"},
+    {"sgi", 3, "image/sgi"},
+    {"", 0, nullptr},
+    {"icc", 3, "application/vnd.iccprofile"},
+    {"txt", 3, "text/plain"},
+    {"rs", 2, "application/rls-services+xml"},
+    {"opf", 3, "application/oebps-package+xml"},
+    {"cpio", 4, "application/x-cpio"},
+    {"", 0, nullptr},
+    {"mfm", 3, "application/vnd.mfmp"},
+    {"box", 3, "application/vnd.previewsystems.box"},
+    {"p12", 3, "application/x-pkcs12"},
+    {"g3", 2, "image/g3fax"},
+    {"mif", 3, "application/vnd.mif"},
+    {"acc", 3, "application/vnd.americandynamics.acc"},
+    {"kwt", 3, "application/vnd.kde.kword"},
+    {"c4p", 3, "application/vnd.clonk.c4group"},
+    {"oxps", 4, "application/oxps"},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"std", 3, "application/vnd.sun.xml.draw.template"},
+    {"flx", 3, "text/vnd.fmi.flexstor"},
+    {"pbm", 3, "image/x-portable-bitmap"},
+    {"ppd", 3, "application/vnd.cups-ppd"},
+    {"nfo", 3, "text/x-nfo"},
+    {"kwd", 3, "application/vnd.kde.kword"},
+    {"", 0, nullptr},
+    {"ogx", 3, "application/ogg"},
+    {"text", 4, "text/plain"},
+    {"ez3", 3, "application/vnd.ezpix-package"},
+    {"mus", 3, "application/vnd.musician"},
+    {"listafp", 7, "application/vnd.ibm.modcap"},
+    {"", 0, nullptr},
+    {"karbon", 6, "application/vnd.kde.karbon"},
+    {"azs", 3, "application/vnd.airzip.filesecure.azs"},
+    {"mks", 3, "video/x-matroska"},
+    {"rtx", 3, "text/richtext"},
+    {"jam", 3, "application/vnd.jam"},
+    {"scq", 3, "application/scvp-cv-request"},
+    {"sbml", 4, "application/sbml+xml"},
+    {"sdc", 3, "application/vnd.stardivision.calc"},
+    {"wmd", 3, "application/x-ms-wmd"},
+    {"m4v", 3, "video/x-m4v"},
+    {"aifc", 4, "audio/x-aiff"},
+    {"hvs", 3, "application/vnd.yamaha.hv-script"},
+    {"semd", 4, "application/vnd.semd"},
+    {"wbxml", 5, "application/vnd.wap.wbxml"},
+    {"woff", 4, "application/x-font-woff"},
+    {"ahead", 5, "application/vnd.ahead.space"},
+    {"vss", 3, "application/vnd.visio"},
+    {"asf", 3, "video/x-ms-asf"},
+    {"jnlp", 4, "application/x-java-jnlp-file"},
+    {"mpg4", 4, "video/mp4"},
+    {"so", 2, "application/octet-stream"},
+    {"cbz", 3, "application/x-cbr"},
+    {"xpi", 3, "application/x-xpinstall"},
+    {"twds", 4, "application/vnd.simtech-mindmapper"},
+    {"eva", 3, "application/x-eva"},
+    {"p", 1, "text/x-pascal"},
+    {"mathml", 6, "application/mathml+xml"},
+    {"", 0, nullptr},
+    {"hpid", 4, "application/vnd.hp-hpid"},
+    {"metalink", 8, "application/metalink+xml"},
+    {"", 0, nullptr},
+    {"xlsx", 4, "application/vnd.openxmlformats-officedocument.spreadsheetml.sheet"},
+    {"", 0, nullptr},
+    {"m1v", 3, "video/mpeg"},
+    {"pbd", 3, "application/vnd.powerbuilder6"},
+    {"wbmp", 4, "image/vnd.wap.wbmp"},
+    {"ftc", 3, "application/vnd.fluxtime.clip"},
+    {"ifb", 3, "text/calendar"},
+    {"xdssc", 5, "application/dssc+xml"},
+    {"pcx", 3, "image/x-pcx"},
+    {"", 0, nullptr},
+    {"jad", 3, "text/vnd.sun.j2me.app-descriptor"},
+    {"onepkg", 6, "application/onenote"},
+    {"rnc", 3, "application/relax-ng-compact-syntax"},
+    {"vcard", 5, "text/vcard"},
+    {"", 0, nullptr},
+    {"avi", 3, "video/x-msvideo"},
+    {"gtar", 4, "application/x-gtar"},
+    {"x3dbz", 5, "model/x3d+binary"},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"jpm", 3, "video/jpm"},
+    {"sm", 2, "application/vnd.stepmania.stepchart"},
+    {"kmz", 3, "application/vnd.google-earth.kmz"},
+    {"sxw", 3, "application/vnd.sun.xml.writer"},
+    {"ai", 2, "application/postscript"},
+    {"wma", 3, "audio/x-ms-wma"},
+    {"", 0, nullptr},
+    {"ggt", 3, "application/vnd.geogebra.tool"},
+    {"xlt", 3, "application/vnd.ms-excel"},
+    {"flac", 4, "audio/x-flac"},
+    {"lnk", 3, "application/x-ms-shortcut"},
+    {"c", 1, "text/x-c"},
+    {"mesh", 4, "model/mesh"},
+    {"potx", 4, "application/vnd.openxmlformats-officedocument.presentationml.template"},
+    {"distz", 5, "application/octet-stream"},
+    {"wmls", 4, "text/vnd.wap.wmlscript"},
+    {"xsl", 3, "application/xml"},
+    {"cc", 2, "text/x-c"},
+    {"js", 2, "application/javascript"},
+    {"vcf", 3, "text/x-vcard"},
+    {"123", 3, "application/vnd.lotus-1-2-3"},
+    {"bin", 3, "application/octet-stream"},
+    {"cer", 3, "application/pkix-cert"},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"vsd", 3, "application/vnd.visio"},
+    {"cdf", 3, "application/x-netcdf"},
+    {"ma", 2, "application/mathematica"},
+    {"pub", 3, "application/x-mspublisher"},
+    {"chrt", 4, "application/vnd.kde.kchart"},
+    {"hlp", 3, "application/winhlp"},
+    {"osf", 3, "application/vnd.yamaha.openscoreformat"},
+    {"gv", 2, "text/vnd.graphviz"},
+    {"cpp", 3, "text/x-c"},
+    {"see", 3, "application/vnd.seemail"},
+    {"psd", 3, "image/vnd.adobe.photoshop"},
+    {"vcg", 3, "application/vnd.groove-vcard"},
+    {"ustar", 5, "application/x-ustar"},
+    {"btif", 4, "image/prs.btif"},
+    {"dataless", 8, "application/vnd.fdsn.seed"},
+    {"sxm", 3, "application/vnd.sun.xml.math"},
+    {"", 0, nullptr},
+    {"plc", 3, "application/vnd.mobius.plc"},
+    {"smf", 3, "application/vnd.stardivision.math"},
+    {"vsw", 3, "application/vnd.visio"},
+    {"rpst", 4, "application/vnd.nokia.radio-preset"},
+    {"gram", 4, "application/srgs"},
+    {"htke", 4, "application/vnd.kenameaapp"},
+    {"vrml", 4, "model/vrml"},
+    {"", 0, nullptr},
+    {"css", 3, "text/css"},
+    {"vob", 3, "video/x-ms-vob"},
+    {"", 0, nullptr},
+    {"smzip", 5, "application/vnd.stepmania.package"},
+    {"mid", 3, "audio/midi"},
+    {"", 0, nullptr},
+    {"uvf", 3, "application/vnd.dece.data"},
+    {"rip", 3, "audio/vnd.rip"},
+    {"tcl", 3, "application/x-tcl"},
+    {"c4d", 3, "application/vnd.clonk.c4group"},
+    {"aas", 3, "application/x-authorware-seg"},
+    {"ram", 3, "audio/x-pn-realaudio"},
+    {"", 0, nullptr},
+    {"ntf", 3, "application/vnd.nitf"},
+    {"dxf", 3, "image/vnd.dxf"},
+    {"uvz", 3, "application/vnd.dece.zip"},
+    {"rpss", 4, "application/vnd.nokia.radio-presets"},
+    {"vst", 3, "application/vnd.visio"},
+    {"", 0, nullptr},
+    {"sv4cpio", 7, "application/x-sv4cpio"},
+    {"mwf", 3, "application/vnd.mfer"},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"ris", 3, "application/x-research-info-systems"},
+    {"igx", 3, "application/vnd.micrografx.igx"},
+    {"", 0, nullptr},
+    {"h261", 4, "video/h261"},
+    {"wmx", 3, "video/x-ms-wmx"},
+    {"sdkd", 4, "application/vnd.solent.sdkm+xml"},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"stk", 3, "application/hyperstudio"},
+    {"tei", 3, "application/tei+xml"},
+    {"udeb", 4, "application/x-debian-package"},
+    {"bcpio", 5, "application/x-bcpio"},
+    {"", 0, nullptr},
+    {"mgz", 3, "application/vnd.proteus.magazine"},
+    {"", 0, nullptr},
+    {"fbs", 3, "image/vnd.fastbidsheet"},
+    {"xbm", 3, "image/x-xbitmap"},
+    {"uvvi", 4, "image/vnd.dece.graphic"},
+    {"jsonml", 6, "application/jsonml+json"},
+    {"gsf", 3, "application/x-font-ghostscript"},
+    {"aep", 3, "application/vnd.audiograph"},
+    {"crl", 3, "application/pkix-crl"},
+    {"azw", 3, "application/vnd.amazon.ebook"},
+    {"3g2", 3, "video/3gpp2"},
+    {"xlw", 3, "application/vnd.ms-excel"},
+    {"otg", 3, "application/vnd.oasis.opendocument.graphics-template"},
+    {"cml", 3, "chemical/x-cml"},
+    {"ami", 3, "application/vnd.amiga.ami"},
+    {"mdi", 3, "image/vnd.ms-modi"},
+    {"", 0, nullptr},
+    {"txf", 3, "application/vnd.mobius.txf"},
+    {"z1", 2, "application/x-zmachine"},
+    {"pqa", 3, "application/vnd.palm"},
+    {"uvva", 4, "audio/vnd.dece.audio"},
+    {"spp", 3, "application/scvp-vp-response"},
+    {"", 0, nullptr},
+    {"oxt", 3, "application/vnd.openofficeorg.extension"},
+    {"lasxml", 6, "application/vnd.las.las+xml"},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"teacher", 7, "application/vnd.smart.teacher"},
+    {"smv", 3, "video/x-smv"},
+    {"svgz", 4, "image/svg+xml"},
+    {"npx", 3, "image/vnd.net-fpx"},
+    {"", 0, nullptr},
+    {"", 0, nullptr},
+    {"utz", 3, "application/vnd.uiq.theme"},
+    {"sig", 3, "application/pgp-signature"},
+};
+
+constexpr char lower(char c) noexcept { return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c; }
+
+constexpr std::uint32_t hash(const char *data, std::size_t size, std::uint32_t seed) noexcept {
+    std::uint32_t h = 2166136261u ^ seed;
+    for (std::size_t i = 0; i < size; ++i) {
+        h ^= static_cast<unsigned char>(lower(data[i]));
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/* The type registered for the extension (without the dot), null when there is none */
+constexpr const char *find(const char *extension, std::size_t size) noexcept {
+    const auto &candidate = slots[hash(extension, size, seeds[hash(extension, size, 0) % bucket_count]) % slot_count];
+    if (candidate.extension_size != size || !candidate.type)
+        return nullptr;
+    for (std::size_t i = 0; i < size; ++i)
+        if (lower(extension[i]) != candidate.extension[i])
+            return nullptr;
+    return candidate.type;
+}
+
+inline const char *find(const std::string &extension) noexcept { return find(extension.data(), extension.size()); }
+}
+
+#endif // MIME_TYPES_H
@@ -24,6 +24,7 @@ namespace http {
 enum status_code {
     OK = 200,
     Found = 302,
+    NotModified = 304,
     BadRequest = 400,
     NotFound = 404,
     UnsupportedMediaType = 415,
@@ -34,8 +35,39 @@ const std::unordered_map<status_code, std::string> status_codes{
     {status_code::OK, "OK"},
     {status_code::BadRequest, "Bad Request"},
     {status_code::Found, "Found"},
+    {status_code::NotModified, "Not Modified"},
     {status_code::NotFound, "Not Found"},
     {status_code::UnsupportedMediaType, "Unsupported Media Type"},
     {status_code::InternalServerError, "Internal Server Error"}};
+
+struct status_line {
+    const char *text;
+    std::size_t size;
+};
+
+template <std::size_t N> constexpr status_line make_status_line(const char (&text)[N]) { return {text, N - 1}; }
+
+/* Ready-made HTTP/1.1 status lines, so that serializing a response does not have to format the code
+ * or look up the reason phrase. Codes without an entry yield {nullptr, 0}.
+ */
+constexpr status_line serialized_status_line(status_code code) {
+    switch (code) {
+    case status_code::OK:
+        return make_status_line("HTTP/1.1 200 OK\r\n");
+    case status_code::Found:
+        return make_status_line("HTTP/1.1 302 Found\r\n");
+    case status_code::NotModified:
+        return make_status_line("HTTP/1.1 304 Not Modified\r\n");
+    case status_code::BadRequest:
+        return make_status_line("HTTP/1.1 400 Bad Request\r\n");
+    case status_code::NotFound:
+        return make_status_line("HTTP/1.1 404 Not Found\r\n");
+    case status_code::UnsupportedMediaType:
+        return make_status_line("HTTP/1.1 415 Unsupported Media Type\r\n");
+    case status_code::InternalServerError:
+        return make_status_line("HTTP/1.1 500 Internal Server Error\r\n");
+    }
+    return {nullptr, 0};
+}
 }
 #endif // STATUS_CODES_H
@@ -22,15 +22,24 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include <future>
 #include <io/buffers/datasource.h>
 
-template <typename T> struct async_buffer : public data_source {
+class schedule_item;
+
+/* The queue waits behind a barrier until it is ready, then puts whatever resolve() gives in its place */
+struct barrier : public data_source {
+    operator bool() const noexcept { return true; }
+    bool intact() const noexcept { return true; }
+    virtual bool is_ready() noexcept = 0;
+    virtual schedule_item resolve() noexcept = 0;
+};
+
+/* A barrier on a future, what resolve() makes of the value is up to the one who waits for it */
+template <typename T> struct async_buffer : public barrier {
     std::future<T> future;
 
     public:
     async_buffer(std::future<T> future) : future(std::move(future)) {}
 
-    operator bool() const noexcept { return true; }
-    bool intact() const noexcept { return true; }
-    bool is_ready() {
+    bool is_ready() noexcept {
         auto result = future.wait_for(std::chrono::seconds(0));
         return (result == std::future_status::ready || result == std::future_status::deferred);
     }
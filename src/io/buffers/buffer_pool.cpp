@@ -16,13 +16,25 @@ License along with this library; if not, write to the Free Software
 Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 
 */
-#ifndef UTILS_H
-#define UTILS_H
+#include <io/buffers/buffer_pool.h>
 
-#include <io/buffers/mem_buffer.h>
-#include <io/buffers/unix_file.h>
-#include <memory>
+using namespace io;
 
-std::unique_ptr<io::memory_buffer> from(const io::unix_file &);
+static thread_local std::vector<std::vector<char>> free_buffers;
 
-#endif // UTILS_H
+std::vector<char> buffer_pool::aquire(std::size_t size) noexcept {
+    std::vector<char> buffer;
+    if (free_buffers.size()) {
+        buffer.swap(free_buffers.back());
+        free_buffers.pop_back();
+    }
+    buffer.reserve(size);
+    return buffer;
+}
+
+void buffer_pool::release(std::vector<char> &&buffer) noexcept {
+    if (buffer.capacity() == 0 || buffer.capacity() > max_pooled_capacity || free_buffers.size() >= max_pooled)
+        return;
+    buffer.clear();
+    free_buffers.emplace_back(std::move(buffer));
+}
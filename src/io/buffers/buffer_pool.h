@@ -0,0 +1,40 @@
+/*
+Copyright (C) 2015 Voinea Constantin Vladimir
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+#ifndef BUFFER_POOL_H
+#define BUFFER_POOL_H
+
+#include <cstddef>
+#include <vector>
+
+namespace io {
+/* Per-thread free list of output buffers. Serialized responses are written straight into
+ * a recycled vector and handed back here when the memory_buffer holding them dies, so the
+ * steady state of a reactor does no allocations for small responses.
+ */
+class buffer_pool {
+    public:
+    static constexpr std::size_t max_pooled = 64;
+    static constexpr std::size_t max_pooled_capacity = 256 * 1024;
+
+    static std::vector<char> aquire(std::size_t) noexcept;
+    static void release(std::vector<char> &&) noexcept;
+};
+}
+
+#endif // BUFFER_POOL_H
@@ -19,6 +19,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #ifndef MEMBUFFER_H
 #define MEMBUFFER_H
 
+#include <io/buffers/buffer_pool.h>
 #include <io/buffers/datasource.h>
 
 #include <vector>
@@ -26,11 +27,16 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 namespace io {
 struct memory_buffer : public data_source {
     std::vector<char> data;
-    std::size_t initial_size;
-
-    memory_buffer(const std::vector<char> &data) : data(data), initial_size(data.size()) {}
-    virtual operator bool() const noexcept { return data.size() != 0; }
-    virtual bool intact() const noexcept { return data.size() == initial_size; }
+    /* Bytes already sent, partial writes move this instead of shifting the rest down */
+    std::size_t offset = 0;
+
+    memory_buffer(const std::vector<char> &data) : data(data) {}
+    memory_buffer(std::vector<char> &&data) : data(std::move(data)) {}
+    virtual ~memory_buffer() { buffer_pool::release(std::move(data)); }
+    virtual operator bool() const noexcept { return offset < data.size(); }
+    virtual bool intact() const noexcept { return offset == 0; }
+    const char *position() const noexcept { return data.data() + offset; }
+    std::size_t size_left() const noexcept { return data.size() - offset; }
 };
 }
 
@@ -0,0 +1,74 @@
+/*
+Copyright (C) 2015 Voinea Constantin Vladimir
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+#include <io/buffers/sealed_memfd.h>
+#include <misc/debug.h>
+
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace io;
+
+sealed_memfd::~sealed_memfd() {
+    if (data_)
+        ::munmap(const_cast<char *>(data_), size_);
+    if (fd_ != -1)
+        ::close(fd_);
+}
+
+std::shared_ptr<const sealed_memfd> sealed_memfd::create(const std::string &name,
+                                                         const std::vector<char> &data) noexcept {
+#if defined(MFD_ALLOW_SEALING) && defined(F_ADD_SEALS)
+    /* Once the kernel said no, don't ask again for every response */
+    static bool supported = true;
+    if (!supported)
+        return nullptr;
+    auto memfd = std::make_shared<sealed_memfd>();
+    memfd->fd_ = ::memfd_create(name.c_str(), MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (memfd->fd_ == -1) {
+        if (errno == ENOSYS || errno == EINVAL)
+            supported = false;
+        debug("memfd_create failed for " + name);
+        return nullptr;
+    }
+    std::size_t written = 0;
+    while (written < data.size()) {
+        auto ret = ::write(memfd->fd_, data.data() + written, data.size() - written);
+        if (ret == -1 && errno == EINTR)
+            continue;
+        if (ret <= 0)
+            return nullptr;
+        written += static_cast<std::size_t>(ret);
+    }
+    if (-1 == ::fcntl(memfd->fd_, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL))
+        return nullptr;
+    memfd->size_ = data.size();
+    if (memfd->size_) {
+        auto mapping = ::mmap(nullptr, memfd->size_, PROT_READ, MAP_SHARED, memfd->fd_, 0);
+        if (mapping != MAP_FAILED)
+            memfd->data_ = static_cast<const char *>(mapping);
+    }
+    return memfd;
+#else
+    (void)name;
+    (void)data;
+    return nullptr;
+#endif
+}
@@ -0,0 +1,54 @@
+/*
+Copyright (C) 2015 Voinea Constantin Vladimir
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+#ifndef SEALED_MEMFD_H
+#define SEALED_MEMFD_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace io {
+/* An anonymous in-memory file holding a copy of some bytes, sealed against any further change.
+ * sendfile() reads it like a regular file, so cached bodies go out without a userspace copy. The bytes can
+ * also be read through a shared mapping of it, which uses the same pages, so the copy they were made from
+ * can be dropped.
+ */
+class sealed_memfd {
+    int fd_ = -1;
+    std::size_t size_ = 0;
+    const char *data_ = nullptr;
+
+    public:
+    /* Null when the kernel doesn't support memfds or sealing */
+    static std::shared_ptr<const sealed_memfd> create(const std::string &name, const std::vector<char> &) noexcept;
+
+    sealed_memfd() = default;
+    sealed_memfd(const sealed_memfd &) = delete;
+    sealed_memfd &operator=(const sealed_memfd &) = delete;
+    ~sealed_memfd();
+
+    int fd() const noexcept { return fd_; }
+    std::size_t size() const noexcept { return size_; }
+    /* Null when the memfd couldn't be mapped */
+    const char *data() const noexcept { return data_; }
+};
+}
+
+#endif // SEALED_MEMFD_H
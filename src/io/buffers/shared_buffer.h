@@ -0,0 +1,41 @@
+/*
+Copyright (C) 2015 Voinea Constantin Vladimir
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+#ifndef SHARED_BUFFER_H
+#define SHARED_BUFFER_H
+
+#include <io/buffers/datasource.h>
+
+#include <memory>
+#include <vector>
+
+namespace io {
+/* Bytes owned by someone else, e.g. a cached resource, sent without being copied */
+struct shared_buffer : public data_source {
+    std::shared_ptr<const std::vector<char>> data;
+    std::size_t offset = 0;
+
+    shared_buffer(std::shared_ptr<const std::vector<char>> data) : data(std::move(data)) {}
+    virtual operator bool() const noexcept { return data && offset < data->size(); }
+    virtual bool intact() const noexcept { return offset == 0; }
+    const char *position() const noexcept { return data->data() + offset; }
+    std::size_t size_left() const noexcept { return data->size() - offset; }
+};
+}
+
+#endif // SHARED_BUFFER_H
@@ -16,16 +16,32 @@ License along with this library; if not, write to the Free Software
 Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 
 */
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
 #include <fcntl.h>
 #include <io/buffers/unix_file.h>
 #include <io/filesystem.h>
+#include <sys/mman.h>
 #include <sys/sendfile.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
 using namespace io;
 
+/* What is dropped behind the cursor is released in steps of this size, not after every write. It trails the
+ * cursor by drop_behind_lag: sendfile() pages still queued in the socket are referenced and can't be dropped
+ */
+static constexpr off64_t drop_behind_step = 1024 * 1024;
+static constexpr off64_t drop_behind_lag = 8 * 1024 * 1024;
+
+/* Files are advised from loader and warmup threads as well as from the reactor */
+static std::atomic<std::uint64_t> advised_count{0};
+static std::atomic<std::uint64_t> read_ahead_bytes{0};
+static std::atomic<std::uint64_t> dropped_bytes{0};
+
 void unix_file::close() {
+    unmap_window();
     if (-1 != fd) {
         release_func_(fd);
     }
@@ -40,37 +56,158 @@ unix_file &unix_file::operator=(unix_file &&other) {
         close();
         fd = other.fd;
         other.fd = -1;
+        size = other.size;
         offset = other.offset;
         other.offset = 0;
+        path = std::move(other.path);
+        aquire_func_ = std::move(other.aquire_func_);
+        release_func_ = std::move(other.release_func_);
+        userspace_ = other.userspace_;
+        begin_ = other.begin_;
+        window_ = other.window_;
+        window_start_ = other.window_start_;
+        window_length_ = other.window_length_;
+        window_mapped_ = other.window_mapped_;
+        other.window_ = nullptr;
+        hints_ = other.hints_;
+        ahead_ = other.ahead_;
+        dropped_ = other.dropped_;
     }
     return *this;
 }
 
-bool unix_file::intact() const noexcept { return offset == 0; }
+bool unix_file::intact() const noexcept { return offset == begin_; }
 
 unix_file::operator bool() const noexcept { return !(offset == size); }
 
-unix_file::unix_file(const std::string &path, aquire_func a, release_func r)
+unix_file::unix_file(const std::string &path, aquire_func a, release_func r, size_func s)
     : path(path), aquire_func_(a), release_func_(r) {
     fd = aquire_func_(path);
     if (-1 == fd)
         throw error{path};
+    if (s && (size = s(fd)) >= 0)
+        return;
     struct stat64 stat;
-    if (-1 == ::stat64(path.c_str(), &stat)) {
+    if (-1 == ::fstat64(fd, &stat)) {
+        close();
         throw error{path};
     }
     size = stat.st_size;
 }
 
-std::uint64_t unix_file::send_to_fd(int other_file) {
-    const ssize_t ret = ::sendfile64(other_file, fd, std::addressof(offset), size_left());
+void unix_file::unmap_window() noexcept {
+    if (!window_)
+        return;
+    if (window_mapped_)
+        ::munmap(window_, window_length_);
+    else
+        delete[] window_;
+    window_ = nullptr;
+}
+
+void unix_file::map_window() {
+    static const off64_t page_size = ::sysconf(_SC_PAGESIZE);
+    unmap_window();
+    window_start_ = offset & ~(page_size - 1);
+    window_length_ = static_cast<std::size_t>(std::min<off64_t>(window_size, size - window_start_));
+    void *mapped = ::mmap64(nullptr, window_length_, PROT_READ, MAP_SHARED, fd, window_start_);
+    if (mapped != MAP_FAILED) {
+        ::madvise(mapped, window_length_, MADV_SEQUENTIAL);
+        window_ = static_cast<char *>(mapped);
+        window_mapped_ = true;
+        return;
+    }
+    /* Some filesystems can't be mapped either, read the window instead */
+    window_ = new char[window_length_];
+    window_mapped_ = false;
+    std::size_t read = 0;
+    while (read < window_length_) {
+        auto ret = ::pread64(fd, window_ + read, window_length_ - read, window_start_ + read);
+        if (ret == -1 && errno == EINTR)
+            continue;
+        if (ret <= 0) {
+            unmap_window();
+            throw bad_file{this};
+        }
+        read += static_cast<std::size_t>(ret);
+    }
+}
+
+std::uint64_t unix_file::send_window(int other_file, std::uint64_t max_bytes) {
+    if (!window_ || offset >= window_start_ + static_cast<off64_t>(window_length_))
+        map_window();
+    const auto position = static_cast<std::size_t>(offset - window_start_);
+    const auto length = std::min<std::uint64_t>(window_length_ - position, max_bytes);
+    const ssize_t ret = ::write(other_file, window_ + position, length);
+    if (ret == -1) {
+        switch (errno) {
+        case EAGAIN:
+        case EINTR:
+            return 0;
+        case EPIPE:
+            throw broken_pipe{this};
+        default:
+            throw bad_file{this};
+        }
+    }
+    offset += ret;
+    if (position + ret == window_length_)
+        unmap_window();
+    follow_cursor();
+    return ret;
+}
+
+void unix_file::advise(const access_hints &hints) noexcept {
+    hints_ = hints;
+    ahead_ = dropped_ = offset;
+    if (!hints.sequential)
+        return;
+    ::posix_fadvise64(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    advised_count.fetch_add(1, std::memory_order_relaxed);
+    follow_cursor();
+}
+
+void unix_file::follow_cursor() noexcept {
+    /* WILLNEED only starts the reads, unlike readahead() it never makes the reactor wait for them */
+    if (hints_.readahead && ahead_ < size && ahead_ - offset <= static_cast<off64_t>(hints_.readahead / 2)) {
+        ahead_ = std::max(ahead_, offset);
+        const auto length = std::min<off64_t>(offset + hints_.readahead, size) - ahead_;
+        if (0 == ::posix_fadvise64(fd, ahead_, length, POSIX_FADV_WILLNEED))
+            read_ahead_bytes.fetch_add(length, std::memory_order_relaxed);
+        ahead_ += length;
+    }
+    if (hints_.drop_behind && offset - drop_behind_lag - dropped_ >= drop_behind_step) {
+        const auto end = (offset - drop_behind_lag) - (offset - drop_behind_lag) % drop_behind_step;
+        if (0 == ::posix_fadvise64(fd, dropped_, end - dropped_, POSIX_FADV_DONTNEED))
+            dropped_bytes.fetch_add(end - dropped_, std::memory_order_relaxed);
+        dropped_ = end;
+    }
+}
+
+unix_file::statistics unix_file::stats() noexcept {
+    statistics result;
+    result.advised = advised_count.load(std::memory_order_relaxed);
+    result.read_ahead = read_ahead_bytes.load(std::memory_order_relaxed);
+    result.dropped = dropped_bytes.load(std::memory_order_relaxed);
+    return result;
+}
+
+std::uint64_t unix_file::send_to_fd(int other_file, std::uint64_t max_bytes) {
+    if (userspace_)
+        return send_window(other_file, max_bytes);
+    const ssize_t ret = ::sendfile64(other_file, fd, std::addressof(offset), std::min(size_left(), max_bytes));
+    if (ret > 0) {
+        follow_cursor();
+        return ret;
+    }
     if (ret == -1) {
         switch (errno) {
         case EAGAIN:
             return 0;
         case EINVAL:
-            throw diy{this};
-            break;
+            /* The filesystem doesn't support sendfile, do it ourselves from now on */
+            userspace_ = true;
+            return send_window(other_file, max_bytes);
         case EBADF:
             throw bad_file{this};
             break;
@@ -90,3 +227,10 @@ std::uint64_t unix_file::send_to_fd(int other_file) {
 }
 
 std::uint64_t unix_file::size_left() const noexcept { return static_cast<std::size_t>(size - offset); }
+
+void unix_file::restrict_to(off64_t begin, off64_t length) noexcept {
+    begin_ = offset = begin;
+    size = begin + length;
+}
+
+off64_t unix_file::length() const noexcept { return size - begin_; }
@@ -22,6 +22,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include <functional>
 #include <io/buffers/datasource.h>
 #include <io/filesystem.h>
+#include <limits>
 #include <string>
 #include <sys/types.h>
 
@@ -34,12 +35,50 @@ struct unix_file : public data_source {
     public:
     typedef std::function<int(const std::string &)> aquire_func;
     typedef std::function<void(int)> release_func;
+    /* Size of an aquired descriptor if the aquire side already knows it, -1 otherwise */
+    typedef std::function<off64_t(int)> size_func;
     fs::path path;
 
+    /* What the userspace fallback maps (or reads) of the file at a time */
+    static constexpr std::size_t window_size = 256 * 1024;
+
+    /* What the kernel is told about how the file will be read while it is sent */
+    struct access_hints {
+        /* posix_fadvise(SEQUENTIAL) on the whole file, and WILLNEED for the first readahead window */
+        bool sequential = false;
+        /* Keep up to this many bytes past what was sent on their way into the page cache. 0 disables it */
+        std::size_t readahead = 0;
+        /* Drop what was sent from the page cache, so that a huge file doesn't evict everything else */
+        bool drop_behind = false;
+    };
+
+    struct statistics {
+        std::uint64_t advised = 0;
+        /* Bytes requested from the disk before sendfile() needed them, i.e. reads it didn't have to wait for */
+        std::uint64_t read_ahead = 0;
+        std::uint64_t dropped = 0;
+    };
+
     private:
     std::function<int(const std::string &)> aquire_func_;
     std::function<void(int)> release_func_;
+    /* Set once sendfile() refused the file. It is then sent from a window that slides over it, so a huge
+     * file never needs more than window_size bytes of memory per connection.
+     */
+    bool userspace_ = false;
+    off64_t begin_ = 0;
+    char *window_ = nullptr;
+    off64_t window_start_ = 0;
+    std::size_t window_length_ = 0;
+    bool window_mapped_ = false;
+    access_hints hints_;
+    off64_t ahead_ = 0;
+    off64_t dropped_ = 0;
     void close();
+    void follow_cursor() noexcept;
+    void map_window();
+    void unmap_window() noexcept;
+    std::uint64_t send_window(int, std::uint64_t);
 
     public:
     struct error {
@@ -52,24 +91,26 @@ struct unix_file : public data_source {
         const unix_file *ptr;
     };
 
-    struct diy {
-        const unix_file *ptr;
-    };
     struct broken_pipe {
         const unix_file *ptr;
     };
 
     unix_file() = default;
     virtual ~unix_file();
-    unix_file(const std::string &, aquire_func a, release_func r);
+    unix_file(const std::string &, aquire_func a, release_func r, size_func s = nullptr);
     unix_file(unix_file &&);
     unix_file &operator=(unix_file &&);
     unix_file(const unix_file &) = delete;
     unix_file &operator=(const unix_file &) = delete;
     virtual operator bool() const noexcept;
     virtual bool intact() const noexcept;
-    std::uint64_t send_to_fd(int);
+    std::uint64_t send_to_fd(int, std::uint64_t max_bytes = std::numeric_limits<std::uint64_t>::max());
     std::uint64_t size_left() const noexcept;
+    /* Sends only length bytes from begin on, e.g. one file out of a bundle */
+    void restrict_to(off64_t begin, off64_t length) noexcept;
+    off64_t length() const noexcept;
+    void advise(const access_hints &) noexcept;
+    static statistics stats() noexcept;
 };
 }
 
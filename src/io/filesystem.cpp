@@ -22,9 +22,19 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include <misc/debug.h>
 
 std::vector<char> io::read_file(const fs::path &path) {
-    std::ifstream stream(path, std::ios::binary);
-    std::vector<char> fileContents((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
-    return fileContents;
+    std::ifstream stream(path, std::ios::binary | std::ios::ate);
+    std::vector<char> contents;
+    if (!stream)
+        return contents;
+    /* One read of the whole file rather than a byte at a time through stream iterators */
+    auto size = static_cast<std::streamoff>(stream.tellg());
+    if (size <= 0)
+        return contents;
+    contents.resize(static_cast<std::size_t>(size));
+    stream.seekg(0);
+    stream.read(contents.data(), size);
+    contents.resize(static_cast<std::size_t>(stream.gcount()));
+    return contents;
 }
 
 std::string io::get_extension(const std::string &path) noexcept {
@@ -17,8 +17,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 
 */
 #include <algorithm>
-#include <io/buffers/utils.h>
 #include <io/schedulers/io_scheduler.h>
+#include <limits>
 #include <io/schedulers/sys_epoll.h>
 #include <misc/common.h>
 #include <misc/debug.h>
@@ -37,6 +37,7 @@ class scheduler::scheduler_impl {
     std::vector<std::unique_ptr<channel>> channels;
     epoll poll;
     scheduler::callback_set callbacks;
+    std::size_t write_quota = std::numeric_limits<std::size_t>::max();
 
     public:
     scheduler_impl() = default;
@@ -85,6 +86,10 @@ class scheduler::scheduler_impl {
         }
     }
 
+    void set_write_quota(std::size_t bytes) noexcept {
+        write_quota = bytes ? bytes : std::numeric_limits<std::size_t>::max();
+    }
+
     void add_new_connections(const channel *channel) noexcept {
         do {
             try {
@@ -107,7 +112,7 @@ class scheduler::scheduler_impl {
                 poll.update(channel);
                 auto &front = *callback_response.front();
                 std::type_index type = typeid(front);
-                if (type == typeid(memory_buffer) || type == typeid(unix_file))
+                if (type == typeid(memory_buffer) || type == typeid(unix_file) || type == typeid(shared_buffer))
                     enqueue_item(channel, callback_response, true);
                 else
                     enqueue_item(channel, callback_response, false);
@@ -121,7 +126,8 @@ class scheduler::scheduler_impl {
     void process_write(channel *channel) noexcept {
         try {
             auto filled = false;
-            while (channel->queue && !filled) {
+            auto budget = write_quota;
+            while (channel->queue && !filled && budget) {
                 if (channel->queue.is_front_async()) {
 
                     /* We've encountered a barrier, that means we have to check if the
@@ -129,9 +135,9 @@ class scheduler::scheduler_impl {
                      * If not, we make the channel level triggered and return
                      */
 
-                    auto new_sync_buffer = callbacks.on_barrier(channel->queue);
-                    if (*new_sync_buffer) {
-                        channel->queue.replace_front(std::move(new_sync_buffer));
+                    auto resolved = callbacks.on_barrier(channel->queue);
+                    if (resolved) {
+                        channel->queue.replace_front(std::move(resolved));
                     } else {
                         channel->flags &= ~epoll::edge_triggered;
                         poll.update(channel);
@@ -139,7 +145,7 @@ class scheduler::scheduler_impl {
                     }
                 }
 
-                filled = fill_channel(channel);
+                filled = fill_channel(channel, budget);
 
                 if (!channel->queue) {
                     if (channel->queue.keep_file_open()) {
@@ -154,7 +160,8 @@ class scheduler::scheduler_impl {
             }
 
             /* If the socket could have had more data written to it, we set it back to level triggered mode so that
-             * the polling service notifies us again
+             * the polling service notifies us again. That's also the case when the channel used up its quota: it
+             * gets its next turn after every other ready channel had one
              */
 
             filled ? channel->flags |= epoll::edge_triggered : channel->flags &= ~epoll::edge_triggered;
@@ -164,24 +171,15 @@ class scheduler::scheduler_impl {
         }
     }
 
-    bool fill_channel(channel *channel) {
+    bool fill_channel(channel *channel, std::size_t &budget) {
         auto &front = *channel->queue.front();
         std::type_index sched_item_type = typeid(front);
 
-        if (sched_item_type == typeid(memory_buffer)) {
-            memory_buffer *mem_buffer = reinterpret_cast<memory_buffer *>(channel->queue.front());
+        if (sched_item_type == typeid(memory_buffer) || sched_item_type == typeid(shared_buffer)) {
             try {
-                if (const auto written = channel->socket->write_some(mem_buffer->data)) {
-                    if (written == mem_buffer->data.size())
-                        channel->queue.remove_front();
-                    else
-                        std::vector<char>(mem_buffer->data.begin() + written, mem_buffer->data.end())
-                            .swap(mem_buffer->data);
-                } else {
-                    return true;
-                }
+                return write_buffers(channel, budget);
             } catch (tcp_socket::write_error) {
-                debug("Caught exception when writing a memory buffer: write_error. errno = " + std::to_string(errno));
+                debug("Caught exception when writing buffers: write_error. errno = " + std::to_string(errno));
                 throw write_error{};
             } catch (tcp_socket::connection_closed_by_peer) {
                 throw write_error{};
@@ -191,25 +189,13 @@ class scheduler::scheduler_impl {
             io::unix_file *unix_file = reinterpret_cast<io::unix_file *>(channel->queue.front());
             try {
                 auto size_left = unix_file->size_left();
-                if (const auto written = unix_file->send_to_fd(channel->socket->get_fd())) {
+                if (const auto written = unix_file->send_to_fd(channel->socket->get_fd(), budget)) {
+                    budget -= written;
                     if (written == size_left)
                         channel->queue.remove_front();
                 } else {
                     return true;
                 }
-            } catch (const unix_file::diy &e) {
-                /* This is how Linux tells you that you'd better do it yourself in userspace.
-                 * We need to replace this item with a MemoryBuffer version of this
-                 * data, at the right offset.
-                 */
-                try {
-                    debug("diy");
-                    auto buffer = from(*e.ptr);
-                    channel->queue.replace_front(std::move(buffer));
-                    return fill_channel(channel);
-                } catch (...) {
-                    throw write_error{};
-                }
             } catch (...) {
                 debug("Caught exception when writing a unix file");
                 throw write_error{};
@@ -218,6 +204,69 @@ class scheduler::scheduler_impl {
         return false;
     }
 
+    /* The bytes left in a buffer held in memory, false when the source isn't one */
+    static bool pending_bytes(data_source *source, const char *&data, std::size_t &size) noexcept {
+        const auto &s = *source;
+        std::type_index type = typeid(s);
+        if (type == typeid(memory_buffer)) {
+            auto *buffer = static_cast<memory_buffer *>(source);
+            data = buffer->position();
+            size = buffer->size_left();
+            return true;
+        }
+        if (type == typeid(shared_buffer)) {
+            auto *buffer = static_cast<shared_buffer *>(source);
+            data = buffer->position();
+            size = buffer->size_left();
+            return true;
+        }
+        return false;
+    }
+
+    static void advance(data_source *source, std::size_t bytes) noexcept {
+        const auto &s = *source;
+        if (typeid(s) == typeid(memory_buffer))
+            static_cast<memory_buffer *>(source)->offset += bytes;
+        else
+            static_cast<shared_buffer *>(source)->offset += bytes;
+    }
+
+    /* The buffers in memory at the front of the queue, typically a header, a body and the ending, go out together in
+     * one sendmsg rather than being copied next to each other first
+     */
+    bool write_buffers(channel *channel, std::size_t &budget) {
+        constexpr std::size_t max_vectors = 16;
+        iovec vectors[max_vectors];
+        std::size_t count = 0, total = 0;
+        auto &queue = channel->queue;
+        const auto buffers = queue.buffers_left();
+        for (; count < buffers && count < max_vectors && total < budget; ++count) {
+            const char *data = nullptr;
+            std::size_t size = 0;
+            if (!pending_bytes(queue.at(count), data, size))
+                break;
+            size = std::min(size, budget - total);
+            vectors[count] = {const_cast<char *>(data), size};
+            total += size;
+        }
+        /* A file sent right after the buffers should share their packets */
+        const bool more = count < buffers;
+        std::size_t written = total ? channel->socket->write_some(vectors, count, more) : 0;
+        if (total && !written)
+            return true;
+        budget -= written;
+        for (std::size_t i = 0; i < count; ++i) {
+            auto *front = queue.front();
+            const auto step = std::min(written, vectors[i].iov_len);
+            advance(front, step);
+            written -= step;
+            if (*front)
+                break;
+            queue.remove_front();
+        }
+        return false;
+    }
+
     void enqueue_item(channel *c, schedule_item &item, bool back) noexcept {
         back ? c->queue.put_back(std::move(item)) : c->queue.put_after_first_intact(std::move(item));
     }
@@ -256,6 +305,8 @@ void scheduler::add(std::unique_ptr<io::tcp_socket> socket, uint32_t flags) {
     }
 }
 
+void scheduler::set_write_quota(std::size_t bytes) noexcept { impl->set_write_quota(bytes); }
+
 void scheduler::run() noexcept { impl->run(); }
 
 scheduler &scheduler::operator=(scheduler &&other) {
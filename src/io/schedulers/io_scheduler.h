@@ -31,7 +31,7 @@ class scheduler {
     typedef schedule_item Resolution;
     typedef std::vector<char> DataType;
     typedef std::function<Resolution(channel *)> read_cb;
-    typedef std::function<std::unique_ptr<memory_buffer>(schedule_item &)> barrier_cb;
+    typedef std::function<schedule_item(schedule_item &)> barrier_cb;
     typedef std::function<void(channel *)> before_removing_cb;
 
     struct callback_set {
@@ -57,6 +57,7 @@ class scheduler {
     scheduler &operator=(scheduler &&);
 
     void add(std::unique_ptr<tcp_socket> socket, std::uint32_t flags);
+    void set_write_quota(std::size_t bytes) noexcept;
     void run() noexcept;
 };
 }
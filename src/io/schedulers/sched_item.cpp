@@ -24,6 +24,10 @@ schedule_item::schedule_item() : m_keep_file_open(false) {}
 
 schedule_item::schedule_item(bool keep_file_open) : m_keep_file_open(keep_file_open) {}
 
+schedule_item::schedule_item(std::unique_ptr<barrier> pending) : m_keep_file_open(false) {
+    buffers.push_back(std::move(pending));
+}
+
 schedule_item::schedule_item(const std::vector<char> &data) : m_keep_file_open(false) {
     buffers.push_back(std::make_unique<memory_buffer>(data));
 }
@@ -32,10 +36,22 @@ schedule_item::schedule_item(const std::vector<char> &data, bool keep_file_open)
     buffers.push_back(std::make_unique<memory_buffer>(data));
 }
 
+schedule_item::schedule_item(std::vector<char> &&data) : m_keep_file_open(false) {
+    buffers.push_back(std::make_unique<memory_buffer>(std::move(data)));
+}
+
+schedule_item::schedule_item(std::vector<char> &&data, bool keep_file_open) : m_keep_file_open(keep_file_open) {
+    buffers.push_back(std::make_unique<memory_buffer>(std::move(data)));
+}
+
+void schedule_item::put_back(std::unique_ptr<barrier> pending) { buffers.push_back(std::move(pending)); }
+
 void schedule_item::put_back(std::unique_ptr<memory_buffer> data) { buffers.push_back(std::move(data)); }
 
 void schedule_item::put_back(std::unique_ptr<unix_file> file) { buffers.push_back(std::move(file)); }
 
+void schedule_item::put_back(std::unique_ptr<shared_buffer> data) { buffers.push_back(std::move(data)); }
+
 void schedule_item::put_back(schedule_item &&other_item) {
     m_keep_file_open = other_item.m_keep_file_open;
     for (auto &&buffer : other_item.buffers)
@@ -52,14 +68,18 @@ void schedule_item::put_after_first_intact(schedule_item other_item) {
                    std::make_move_iterator(other_item.buffers.rend()));
 }
 
-void schedule_item::replace_front(std::unique_ptr<memory_buffer> with) noexcept { buffers.front() = std::move(with); }
+void schedule_item::replace_front(schedule_item &&with) {
+    buffers.erase(buffers.begin());
+    buffers.insert(buffers.begin(), std::make_move_iterator(with.buffers.begin()),
+                   std::make_move_iterator(with.buffers.end()));
+}
 
 bool schedule_item::is_front_async() const noexcept {
     if (!buffers_left())
         return false;
     const auto &front = *c_front();
     std::type_index type = typeid(front);
-    if (type == typeid(memory_buffer) || type == typeid(unix_file))
+    if (type == typeid(memory_buffer) || type == typeid(unix_file) || type == typeid(shared_buffer))
         return false;
     return true;
 }
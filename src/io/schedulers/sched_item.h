@@ -22,6 +22,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include <deque>
 #include <io/buffers/asyncbuffer.h>
 #include <io/buffers/mem_buffer.h>
+#include <io/buffers/shared_buffer.h>
 #include <io/buffers/unix_file.h>
 #include <memory>
 
@@ -46,22 +47,26 @@ class schedule_item {
     schedule_item(bool keep_file_open);
     explicit schedule_item(const std::vector<char> &data);
     schedule_item(const std::vector<char> &data, bool);
+    explicit schedule_item(std::vector<char> &&data);
+    schedule_item(std::vector<char> &&data, bool);
 
-    template <typename T> schedule_item(std::unique_ptr<async_buffer<T>> future) {
-        buffers.emplace_back(std::move(future));
-    }
+    schedule_item(std::unique_ptr<barrier> pending);
 
+    void put_back(std::unique_ptr<barrier> pending);
     void put_back(std::unique_ptr<io::memory_buffer> data);
     void put_back(std::unique_ptr<io::unix_file> file);
+    void put_back(std::unique_ptr<io::shared_buffer> data);
     void put_back(schedule_item &&);
 
     void put_after_first_intact(std::unique_ptr<io::memory_buffer> data);
     void put_after_first_intact(std::unique_ptr<io::unix_file> file);
     void put_after_first_intact(schedule_item);
 
-    void replace_front(std::unique_ptr<io::memory_buffer>) noexcept;
+    /* The buffers of the item take the place of the front one, e.g. of a barrier that was resolved */
+    void replace_front(schedule_item &&);
     inline data_source *front() noexcept { return buffers.front().get(); }
     inline const data_source *c_front() const noexcept { return buffers.front().get(); }
+    inline data_source *at(std::size_t index) noexcept { return buffers[index].get(); }
     bool is_front_async() const noexcept;
     inline void remove_front() noexcept { buffers.erase(buffers.begin()); }
     inline bool keep_file_open() const noexcept { return this->m_keep_file_open; }
@@ -26,6 +26,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include <sys/socket.h>
 #include <sys/time.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #include <vector>
 
@@ -95,9 +96,11 @@ class tcp_socket {
         return result;
     }
 
-    template <typename T> std::size_t write_some(const T &data) const {
+    template <typename T> std::size_t write_some(const T &data) const { return write_some(data.data(), data.size()); }
 
-        auto total_to_write = data.size();
+    std::size_t write_some(const char *data, std::size_t size) const {
+
+        auto total_to_write = size;
         std::size_t bytes_written_total = 0;
         ssize_t bytes_written_loop = 0;
 
@@ -108,7 +111,7 @@ class tcp_socket {
             if (left_to_write >= page_size / 2)
                 flags |= MSG_MORE;
             bytes_written_loop =
-                ::send(fd_, static_cast<const void *>(data.data() + bytes_written_total), left_to_write, flags);
+                ::send(fd_, static_cast<const void *>(data + bytes_written_total), left_to_write, flags);
             if (bytes_written_loop > 0)
                 bytes_written_total += bytes_written_loop;
         } while (bytes_written_loop > 0 && bytes_written_total < total_to_write);
@@ -127,6 +130,27 @@ class tcp_socket {
         return bytes_written_total;
     }
 
+    /* Several buffers in one call. more tells the kernel that further data follows right after them */
+    std::size_t write_some(const iovec *vectors, std::size_t count, bool more) const {
+        msghdr message{};
+        message.msg_iov = const_cast<iovec *>(vectors);
+        message.msg_iovlen = count;
+        const auto bytes_written = ::sendmsg(fd_, &message, MSG_NOSIGNAL | (more ? MSG_MORE : 0));
+        if (bytes_written == -1) {
+            switch (errno) {
+            case EWOULDBLOCK:
+            case EINTR:
+                return 0;
+            case EPIPE:
+            case ECONNRESET:
+                throw connection_closed_by_peer{fd_, this};
+            default:
+                throw write_error{fd_, this};
+            }
+        }
+        return static_cast<std::size_t>(bytes_written);
+    }
+
     private:
     int fd_ = -1;
     bool connection_ = false;
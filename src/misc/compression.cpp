@@ -0,0 +1,283 @@
+/*
+Copyright (C) 2015 Voinea Constantin Vladimir
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+#include <misc/compression.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <new>
+
+#ifdef VIKING_BROTLI
+#include <brotli/encode.h>
+#endif
+#ifdef VIKING_ZSTD
+#include <zstd.h>
+#endif
+
+using namespace compression;
+
+struct stream::context {
+    z_stream z{};
+    format type;
+    int level;
+
+    context(format type, int level) : type(type), level(level) {
+        constexpr auto window_bits = 15;
+        constexpr auto gzip_encoding = 16;
+        const auto bits = type == format::gzip ? window_bits | gzip_encoding
+                                               : type == format::raw ? -window_bits : window_bits;
+        if (Z_OK != deflateInit2(&z, level, Z_DEFLATED, bits, 8, Z_DEFAULT_STRATEGY))
+            throw std::bad_alloc{};
+    }
+    ~context() { deflateEnd(&z); }
+};
+
+namespace {
+/* Each context holds about 256KB, a handful per thread covers the levels and formats in use */
+constexpr std::size_t max_idle = 8;
+thread_local std::vector<std::unique_ptr<stream::context>> idle;
+}
+
+stream::stream(format type, int level) : context_(nullptr) {
+    for (auto it = idle.rbegin(); it != idle.rend(); ++it) {
+        if ((*it)->type == type && (*it)->level == level) {
+            context_ = it->release();
+            idle.erase(std::next(it).base());
+            return;
+        }
+    }
+    context_ = new context(type, level);
+}
+
+stream::~stream() { give_back(); }
+
+void stream::give_back() noexcept {
+    if (!context_)
+        return;
+    std::unique_ptr<context> owned{context_};
+    context_ = nullptr;
+    if (Z_OK != deflateReset(&owned->z))
+        return;
+    if (idle.size() >= max_idle)
+        idle.erase(idle.begin());
+    idle.emplace_back(std::move(owned));
+}
+
+stream::stream(stream &&other) noexcept : context_(other.context_) { other.context_ = nullptr; }
+
+stream &stream::operator=(stream &&other) noexcept {
+    if (this != &other) {
+        give_back();
+        context_ = other.context_;
+        other.context_ = nullptr;
+    }
+    return *this;
+}
+
+std::size_t stream::bound(std::size_t size) const noexcept { return deflateBound(&context_->z, size); }
+
+void stream::prime(const char *dictionary, std::size_t size) {
+    const auto *bytes = reinterpret_cast<const Bytef *>(dictionary);
+    if (Z_OK != deflateSetDictionary(&context_->z, bytes, static_cast<uInt>(size)))
+        throw error{};
+}
+
+bool stream::step(const char *&data, std::size_t &size, char *out, std::size_t &room, int flush) {
+    auto &z = context_->z;
+    z.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+    z.avail_in = static_cast<uInt>(size);
+    z.next_out = reinterpret_cast<Bytef *>(out);
+    z.avail_out = static_cast<uInt>(room);
+    const auto result = ::deflate(&z, flush);
+    data += size - z.avail_in;
+    size = z.avail_in;
+    room = z.avail_out;
+    if (result == Z_STREAM_ERROR)
+        throw error{};
+    if (flush == Z_FINISH)
+        return result == Z_STREAM_END;
+    /* Input left over or a full output buffer means zlib has more to say */
+    return size == 0 && room != 0;
+}
+
+namespace {
+/* The largest distance deflate looks back */
+constexpr std::size_t window_size = 32 * 1024;
+
+/* One parallel() call. Whoever runs it takes the next block nobody took yet, until there are none */
+struct parallel_job {
+    format type;
+    const char *data;
+    std::size_t size;
+    int level;
+    std::size_t block_size;
+    std::size_t count;
+    std::vector<std::vector<char>> pieces;
+    std::vector<uLong> checks;
+    std::atomic<std::size_t> next{0};
+    std::atomic<bool> failed{false};
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::size_t done = 0;
+
+    parallel_job(format type, const char *data, std::size_t size, int level, std::size_t block_size)
+        : type(type), data(data), size(size), level(level), block_size(block_size),
+          count((size + block_size - 1) / block_size), pieces(count), checks(count) {}
+
+    std::size_t length(std::size_t block) const noexcept { return std::min(block_size, size - block * block_size); }
+
+    /* Every block but the last ends with a sync flush: byte aligned and not final, so the pieces can be joined */
+    void compress(std::size_t block) {
+        const auto *begin = data + block * block_size;
+        const auto size = length(block);
+        stream compressor{format::raw, level};
+        if (block) {
+            const auto dictionary = std::min(window_size, block * block_size);
+            compressor.prime(begin - dictionary, dictionary);
+        }
+        auto &out = pieces[block];
+        out.reserve(compressor.bound(size));
+        if (block + 1 == count) {
+            compressor.finish(begin, size, out);
+        } else {
+            compressor.write(begin, size, out);
+            compressor.flush(out);
+        }
+        const auto *bytes = reinterpret_cast<const Bytef *>(begin);
+        checks[block] = type == format::gzip ? crc32(0, bytes, static_cast<uInt>(size))
+                                             : adler32(1, bytes, static_cast<uInt>(size));
+    }
+
+    void run() noexcept {
+        for (std::size_t block; (block = next++) < count;) {
+            try {
+                compress(block);
+            } catch (...) {
+                failed = true;
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                ++done;
+            }
+            finished.notify_all();
+        }
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [this]() { return done == count; });
+    }
+};
+
+template <typename T> void put_little_endian(std::vector<char> &out, T value) {
+    for (std::size_t i = 0; i < sizeof(T); ++i)
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+}
+
+template <typename T> void put_big_endian(std::vector<char> &out, T value) {
+    for (std::size_t i = sizeof(T); i--;)
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+}
+}
+
+std::vector<char> compression::parallel(thread_pool &pool, format type, const char *data, std::size_t size, int level,
+                                        std::size_t block_size) {
+    if (type == format::raw || !block_size || size <= block_size || !pool.size()) {
+        stream compressor{type, level};
+        std::vector<char> out;
+        out.reserve(compressor.bound(size));
+        compressor.finish(data, size, out);
+        return out;
+    }
+    auto job = std::make_shared<parallel_job>(type, data, size, level, block_size);
+    for (std::size_t helpers = std::min(pool.size(), job->count - 1); helpers; --helpers)
+        pool.submit([job]() { job->run(); });
+    job->run();
+    job->wait();
+    if (job->failed)
+        throw stream::error{};
+
+    std::size_t total = 18;
+    for (const auto &piece : job->pieces)
+        total += piece.size();
+    std::vector<char> out;
+    out.reserve(total);
+    if (type == format::gzip) {
+        /* No name, no time, unknown OS */
+        out.insert(out.end(), {'\x1f', '\x8b', 8, 0, 0, 0, 0, 0, 0, 3});
+    } else {
+        /* 32KB window and a level hint, the check bits make the header a multiple of 31 */
+        const unsigned method = 0x78;
+        unsigned flags = (level == 1 ? 0 : level > 1 && level < 6 ? 1 : level > 6 ? 3 : 2) << 6;
+        flags += 31 - (method * 256 + flags) % 31;
+        out.push_back(static_cast<char>(method));
+        out.push_back(static_cast<char>(flags));
+    }
+    uLong check = job->checks[0];
+    for (std::size_t block = 0; block < job->count; ++block) {
+        out.insert(out.end(), job->pieces[block].begin(), job->pieces[block].end());
+        if (!block)
+            continue;
+        const auto length = static_cast<z_off_t>(job->length(block));
+        check = type == format::gzip ? crc32_combine(check, job->checks[block], length)
+                                     : adler32_combine(check, job->checks[block], length);
+    }
+    if (type == format::gzip) {
+        put_little_endian(out, static_cast<std::uint32_t>(check));
+        put_little_endian(out, static_cast<std::uint32_t>(size));
+    } else {
+        put_big_endian(out, static_cast<std::uint32_t>(check));
+    }
+    return out;
+}
+
+#ifdef VIKING_BROTLI
+std::vector<char> compression::brotli(const char *data, std::size_t size, int quality) {
+    std::vector<char> out(BrotliEncoderMaxCompressedSize(size));
+    auto out_size = out.size();
+    if (out.empty() || !BrotliEncoderCompress(quality, BROTLI_DEFAULT_WINDOW, BROTLI_MODE_GENERIC, size,
+                                              reinterpret_cast<const std::uint8_t *>(data), &out_size,
+                                              reinterpret_cast<std::uint8_t *>(out.data())))
+        throw stream::error{};
+    out.resize(out_size);
+    return out;
+}
+#endif
+
+#ifdef VIKING_ZSTD
+namespace {
+struct zstd_context {
+    ZSTD_CCtx *context = ZSTD_createCCtx();
+    ~zstd_context() { ZSTD_freeCCtx(context); }
+};
+thread_local zstd_context zstd_compressor;
+}
+
+std::vector<char> compression::zstd(const char *data, std::size_t size, int level) {
+    if (!zstd_compressor.context)
+        throw std::bad_alloc{};
+    std::vector<char> out(ZSTD_compressBound(size));
+    const auto written = ZSTD_compressCCtx(zstd_compressor.context, out.data(), out.size(), data, size, level);
+    if (ZSTD_isError(written))
+        throw stream::error{};
+    out.resize(written);
+    return out;
+}
+#endif
@@ -19,55 +19,115 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #ifndef COMPRESSION_H
 #define COMPRESSION_H
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <misc/thread_pool.h>
 #include <vector>
 #include <zlib.h>
 
+/* brotli and zstd are optional, the build defines VIKING_BROTLI and VIKING_ZSTD for the libraries it finds */
+
 namespace compression {
-template <typename T> T deflate(const T &data) {
+/* raw is deflate data without the zlib header and trailer */
+enum class format : std::uint8_t { deflate, gzip, raw };
+
+/* Compresses a body piece by piece, appending the output to a buffer of the caller's. The zlib state is taken
+ * from a per-thread free list and handed back to it, reset rather than freed, when the stream goes away, so once
+ * a thread has warmed up compressing allocates nothing inside zlib.
+ */
+class stream {
+    public:
+    struct context;
+
+    private:
+    context *context_;
+    void give_back() noexcept;
+    bool step(const char *&data, std::size_t &size, char *out, std::size_t &room, int flush);
+
+    template <typename Container> void pump(const char *data, std::size_t size, int flush, Container &out) {
+        for (bool done = false; !done;) {
+            const auto used = out.size();
+            const auto room = std::max<std::size_t>(bound(size), 64);
+            auto left = room;
+            out.resize(used + room);
+            done = step(data, size, &out[used], left, flush);
+            out.resize(used + room - left);
+        }
+    }
+
+    public:
+    struct error {};
+
+    stream(format, int level);
+    ~stream();
+    stream(const stream &) = delete;
+    stream &operator=(const stream &) = delete;
+    stream(stream &&) noexcept;
+    stream &operator=(stream &&) noexcept;
+
+    template <typename Container> void write(const char *data, std::size_t size, Container &out) {
+        pump(data, size, Z_NO_FLUSH, out);
+    }
+    /* Everything written so far comes out, ending on a byte boundary, e.g. to close a chunk */
+    template <typename Container> void flush(Container &out) { pump(nullptr, 0, Z_SYNC_FLUSH, out); }
+    /* Compresses the last piece and ends the stream */
+    template <typename Container> void finish(const char *data, std::size_t size, Container &out) {
+        pump(data, size, Z_FINISH, out);
+    }
+    template <typename Container> void finish(Container &out) { finish(nullptr, 0, out); }
+    /* Raw streams only, before anything was written: back references may reach into this data */
+    void prime(const char *dictionary, std::size_t size);
+    /* How big the output for this much input can get */
+    std::size_t bound(std::size_t) const noexcept;
+};
+
+template <typename T = std::vector<char>> T deflate(const char *data, std::size_t size, int level) {
+    stream compressor{format::deflate, level};
     T deflated;
-    deflated.resize(compressBound(data.size()));
-
-    z_stream defstream;
-    defstream.zalloc = Z_NULL;
-    defstream.zfree = Z_NULL;
-    defstream.opaque = Z_NULL;
-
-    defstream.avail_in = (uInt)data.size();
-    defstream.next_in = (Bytef *)&data.front();
-    defstream.avail_out = (uInt)deflated.size();
-    defstream.next_out = (Bytef *)&deflated.front();
-
-    deflateInit(&defstream, Z_BEST_COMPRESSION);
-    deflate(&defstream, Z_FINISH);
-    deflateEnd(&defstream);
-    deflated.resize(defstream.total_out);
-
+    deflated.reserve(compressor.bound(size));
+    compressor.finish(data, size, deflated);
     return deflated;
 }
 
-template <typename T> T gzip(const T &data) {
-    T gzipped;
-    gzipped.resize(compressBound(data.size()));
+template <typename T> T deflate(const T &data, int level = Z_BEST_COMPRESSION) {
+    return deflate<T>(data.data(), data.size(), level);
+}
 
-    z_stream defstream;
-    defstream.zalloc = Z_NULL;
-    defstream.zfree = Z_NULL;
-    defstream.opaque = Z_NULL;
+template <typename T = std::vector<char>> T gzip(const char *data, std::size_t size, int level) {
+    stream compressor{format::gzip, level};
+    T gzipped;
+    gzipped.reserve(compressor.bound(size));
+    compressor.finish(data, size, gzipped);
+    return gzipped;
+}
 
-    defstream.avail_in = (uInt)data.size();
-    defstream.next_in = (Bytef *)&data.front();
-    defstream.avail_out = (uInt)gzipped.size();
-    defstream.next_out = (Bytef *)&gzipped.front();
+template <typename T> T gzip(const T &data, int level = Z_DEFAULT_COMPRESSION) {
+    return gzip<T>(data.data(), data.size(), level);
+}
 
-    constexpr auto windowsBits = 15;
-    constexpr auto GZIP_ENCODING = 16;
-    deflateInit2(&defstream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, windowsBits | GZIP_ENCODING, 8, Z_DEFAULT_STRATEGY);
-    deflate(&defstream, Z_FINISH);
-    deflateEnd(&defstream);
-    gzipped.resize(defstream.total_out);
+/* pigz-like: the body is cut into blocks of block_size that are compressed side by side on the pool, each primed
+ * with the 32KB in front of it, and joined behind one header with their checksums combined. The calling thread
+ * compresses blocks too, so calling this from a task of the same pool is fine. deflate and gzip only
+ */
+std::vector<char> parallel(thread_pool &, format, const char *data, std::size_t size, int level,
+                           std::size_t block_size);
+
+#ifdef VIKING_BROTLI
+/* quality goes from 0 to 11 */
+std::vector<char> brotli(const char *data, std::size_t size, int quality);
+inline std::vector<char> brotli(const std::vector<char> &data, int quality) {
+    return brotli(data.data(), data.size(), quality);
+}
+#endif
 
-    return gzipped;
+#ifdef VIKING_ZSTD
+/* The context is kept per thread, like the zlib ones */
+std::vector<char> zstd(const char *data, std::size_t size, int level);
+inline std::vector<char> zstd(const std::vector<char> &data, int level) {
+    return zstd(data.data(), data.size(), level);
 }
+#endif
 }
 
 #endif // COMPRESSION_H
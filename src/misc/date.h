@@ -34,6 +34,30 @@ struct date {
 
     static date now() { return date(time(0)); }
 
+    /* Formatting is comparatively expensive, so every thread (i.e. every reactor) keeps the last
+     * rendered value and only formats a new one when the second changes.
+     */
+    static const std::string &now_string() {
+        static thread_local time_t last = 0;
+        static thread_local std::string text;
+        auto current = time(0);
+        if (current != last) {
+            last = current;
+            text = date(current).to_string();
+        }
+        return text;
+    }
+
+    /* Reads the format to_string() writes, as clients send it back in If-Modified-Since */
+    static bool parse(const std::string &text, time_t &time) {
+        struct tm parsed = {};
+        auto end = strptime(text.c_str(), "%a, %d %b %Y %H:%M:%S GMT", &parsed);
+        if (!end || *end)
+            return false;
+        time = timegm(&parsed);
+        return true;
+    }
+
     std::string to_string() {
         std::string text;
         text.resize(100);
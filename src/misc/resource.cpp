@@ -23,9 +23,37 @@ const fs::path &resource::path() const { return _path; }
 const fs::file_time_type &resource::last_write() const { return _last_write; }
 
 resource::resource(const fs::path &path, const std::vector<char> &content)
-    : _path(path), _last_write(fs::last_write_time(path)), raw(content) {}
+    : _path(path), _last_write(fs::last_write_time(path)), raw(std::make_shared<const std::vector<char>>(content)) {
+}
 
 resource::resource(const fs::path &path)
-    : _path(path), _last_write(fs::last_write_time(path)), raw(io::read_file(path)) {}
-
-resource::operator bool() { return (raw.size() != 0); }
+    : _path(path), _last_write(fs::last_write_time(path)),
+      raw(std::make_shared<const std::vector<char>>(io::read_file(path))) {}
+
+std::size_t resource::footprint() const noexcept {
+    std::size_t total = 0;
+    for (const buffer *variant : {&raw, &deflated, &gzipped, &raw_fields, &deflated_fields, &gzipped_fields})
+        if (*variant)
+            total += (*variant)->size();
+    for (const memfd *variant : {&raw_memfd, &deflated_memfd, &gzipped_memfd})
+        if (*variant)
+            total += (*variant)->size();
+    return total;
+}
+
+bool resource::same_variants(const resource &other) const noexcept {
+    return raw == other.raw && deflated == other.deflated && gzipped == other.gzipped &&
+           raw_fields == other.raw_fields && deflated_fields == other.deflated_fields &&
+           gzipped_fields == other.gzipped_fields && raw_memfd == other.raw_memfd &&
+           deflated_memfd == other.deflated_memfd && gzipped_memfd == other.gzipped_memfd;
+}
+
+resource::view resource::bytes(const buffer &vector, const memfd &sealed) noexcept {
+    if (vector)
+        return {vector->data(), vector->size()};
+    if (sealed && sealed->data())
+        return {sealed->data(), sealed->size()};
+    return {};
+}
+
+resource::operator bool() { return raw_bytes().size != 0; }
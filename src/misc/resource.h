@@ -19,7 +19,9 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #ifndef RESOURCE_H
 #define RESOURCE_H
 
+#include <io/buffers/sealed_memfd.h>
 #include <io/filesystem.h>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -28,9 +30,36 @@ class resource {
     fs::file_time_type _last_write;
 
     public:
-    std::vector<char> raw;
-    std::vector<char> deflated;
-    std::vector<char> gzipped;
+    /* Immutable once built, so responses and the scheduler share them instead of copying */
+    typedef std::shared_ptr<const std::vector<char>> buffer;
+
+    buffer raw;
+    buffer deflated;
+    buffer gzipped;
+    /* Header lines of each variant that are the same on every hit, rendered once and spliced into responses */
+    buffer raw_fields;
+    buffer deflated_fields;
+    buffer gzipped_fields;
+    /* Sealed memfd copies of the variants for sendfile, created on demand when configuration::cache_in_memfd is set.
+     * Once a variant has one, its buffer above is released and its bytes are read through the memfd's mapping
+     */
+    typedef std::shared_ptr<const io::sealed_memfd> memfd;
+    memfd raw_memfd;
+    memfd deflated_memfd;
+    memfd gzipped_memfd;
+
+    /* The bytes of a variant wherever they are kept, empty when there is no such variant */
+    struct view {
+        const char *data = nullptr;
+        std::size_t size = 0;
+        explicit operator bool() const noexcept { return data != nullptr; }
+    };
+    static view bytes(const buffer &, const memfd &) noexcept;
+    view raw_bytes() const noexcept { return bytes(raw, raw_memfd); }
+    view deflated_bytes() const noexcept { return bytes(deflated, deflated_memfd); }
+    view gzipped_bytes() const noexcept { return bytes(gzipped, gzipped_memfd); }
+    /* What the compression policy decided, meaningful once any of the fields above is rendered */
+    bool compressible = false;
     resource() = default;
     resource(const fs::path &, const std::vector<char> &);
     resource(const fs::path &);
@@ -39,6 +68,10 @@ class resource {
 
     const fs::path &path() const;
     const fs::file_time_type &last_write() const;
+    /* Bytes held by all the variants */
+    std::size_t footprint() const noexcept;
+    /* Whether both hold the very same variants, i.e. a response added nothing the cache should keep */
+    bool same_variants(const resource &) const noexcept;
 };
 
 #endif // RESOURCE_H
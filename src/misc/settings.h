@@ -18,6 +18,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 */
 #ifndef SETTINGS_H
 #define SETTINGS_H
+#include <http/delivery_policy.h>
 #include <http/request.h>
 #include <http/resolution.h>
 #include <string>
@@ -30,8 +31,72 @@ struct configuration {
     std::uint32_t max_connections;
     std::uint32_t default_max_age = 300;
     bool allow_directory_listing;
+    /* Directory listings are split into pages of this many entries (?page=N). 0 lists everything at once */
+    std::size_t directory_page_size = 1000;
     bool enable_compression;
+    /* Bodies smaller than this are sent as they are */
+    std::size_t compression_min_size = 256;
+    /* zlib levels for text-like content and for everything else we don't know to be compressed already */
+    int compression_level_text = 6;
+    int compression_level_binary = 1;
+    /* Generated bodies go out as zstd or brotli to clients that prefer those, when the server was built with them */
+    int compression_level_zstd = 3;
+    int compression_level_brotli = 5;
+    /* Generated bodies from this size on are compressed on compression_threads rather than on the reactor, gzip and
+     * deflate ones cut into blocks of compression_block_size compressed side by side. 0 threads compresses inline
+     */
+    std::size_t compression_offload_min_size = 1024 * 1024;
+    std::uint32_t compression_threads = 2;
+    std::size_t compression_block_size = 128 * 1024;
+    /* Unknown binaries whose sampled entropy (bits per byte) is above this are skipped. 0 disables sampling */
+    double compression_max_entropy = 7.5;
+    /* Write file.gz (and file.br, with brotli) next to every compressible static file when the configuration is
+     * applied
+     */
+    bool precompress_on_startup = false;
+    /* Upper bound for the in-memory static file cache, compressed variants included */
+    std::size_t cache_byte_budget = 64 * 1024 * 1024;
+    /* Watch root_path with inotify so that cache hits never have to check the disk */
+    bool watch_filesystem = true;
+    /* Without a watcher, how long (in ms) a cached entry is trusted before it is checked against the disk again */
+    std::uint32_t cache_staleness_ms = 1000;
+    /* Descriptors of files that are not being sent kept open for the next request, least recently used go first */
+    std::size_t fd_cache_size = 256;
+    /* Keep large cached bodies in sealed memfds instead of vectors and send them with sendfile */
+    bool cache_in_memfd = false;
+    /* How many resolved request paths are remembered, and for how long (in ms) one that didn't exist is */
+    std::size_t path_cache_size = 4096;
+    std::uint32_t path_cache_negative_ttl_ms = 2000;
+    /* Files up to this size are served from memory once they were requested delivery_hot_threshold times lately */
+    std::uintmax_t delivery_memory_max_size = 256 * 1024;
+    std::uint32_t delivery_hot_threshold = 2;
+    /* Threads reading files that aren't cached yet, so that a slow disk doesn't stall the reactor. 0 reads them
+     * on the reactor
+     */
+    std::uint32_t cold_load_threads = 2;
+    /* Urls (one per line) loaded into the cache, compressed variants included, when the configuration is applied */
+    std::string warmup_manifest;
+    std::uint32_t warmup_threads = 4;
+    /* The cache is written here when the server goes away, and what is still current is loaded back at startup */
+    std::string cache_snapshot;
+    /* Files packed into this bundle (see tools/bundle) are served from it before root_path is looked at */
+    std::string bundle_path;
+    /* At most this many bytes are written to one connection per wakeup, the rest waits for the other connections
+     * to get their turn. 0 lets a connection write until its socket is full
+     */
+    std::size_t write_quota = 256 * 1024;
+    /* Files sent with sendfile that are at least this large are read sequentially: the kernel is told so when they
+     * are opened and stream_readahead bytes past what was sent are kept on their way from the disk
+     */
+    std::uintmax_t stream_sequential_min_size = 1024 * 1024;
+    std::size_t stream_readahead = 2 * 1024 * 1024;
+    /* Files at least this large are dropped from the page cache once sent, so that streaming them doesn't evict the
+     * files everybody asks for. 0 never drops them
+     */
+    std::uintmax_t stream_drop_behind_min_size = 512 * 1024 * 1024;
     std::function<http::resolution(http::request)> folder_cb;
+    /* Replaces the standard static delivery rules when set */
+    http::delivery_policy::chooser delivery_cb;
 };
 
 #endif // SETTINGS_H
@@ -0,0 +1,61 @@
+/*
+Copyright (C) 2015 Voinea Constantin Vladimir
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* A fixed set of worker threads for work that must stay off the reactor, like reading files that
+ * aren't cached yet. Results come back as futures, which the scheduler already knows how to wait for.
+ */
+class thread_pool {
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable available;
+    bool stopping = false;
+
+    void enqueue(std::function<void()> task);
+    void work() noexcept;
+
+    public:
+    explicit thread_pool(std::size_t threads);
+    ~thread_pool();
+    thread_pool(const thread_pool &) = delete;
+    thread_pool &operator=(const thread_pool &) = delete;
+
+    std::size_t size() const noexcept { return workers.size(); }
+
+    template <typename F> auto submit(F &&function) -> std::future<decltype(function())> {
+        typedef decltype(function()) result_type;
+        auto task = std::make_shared<std::packaged_task<result_type()>>(std::forward<F>(function));
+        auto future = task->get_future();
+        enqueue([task]() { (*task)(); });
+        return future;
+    }
+};
+
+#endif // THREAD_POOL_H
@@ -16,6 +16,10 @@ License along with this library; if not, write to the Free Software
 Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 
 */
+#include <cache/bundle.h>
+#include <cache/precompressed.h>
+#include <cache/warmup.h>
+#include <cache/watcher.h>
 #include <http/dispatcher/dispatcher.h>
 #include <io/schedulers/channel.h>
 #include <io/schedulers/io_scheduler.h>
@@ -43,17 +47,20 @@ class server::server_impl {
     inline void ignore_sigpipe() { signal(SIGPIPE, SIG_IGN); }
 
     auto handle_barrier(schedule_item &schedule_item) {
-        if (schedule_item.is_front_async()) {
-            async_buffer<http::response> *buffer = static_cast<async_buffer<http::response> *>(schedule_item.front());
-            if (buffer->is_ready())
-                return m_dispatcher.handle_barrier(buffer);
-        }
-        return std::make_unique<memory_buffer>(std::vector<char>{});
+        if (schedule_item.is_front_async())
+            return m_dispatcher.handle_barrier(schedule_item.front());
+        return ::schedule_item{};
     }
 
     public:
     server_impl(int port) : m_port(port), m_stop_requested(false) {}
 
+    ~server_impl() {
+        const auto &snapshot = storage::config().cache_snapshot;
+        if (!snapshot.empty())
+            cache::warmup::save_snapshot(snapshot);
+    }
+
     inline void init() {
         ignore_sigpipe();
         debug("Pid = " + std::to_string(getpid()));
@@ -67,6 +74,7 @@ class server::server_impl {
             callbacks.on_remove = std::bind(&dispatcher::will_remove, &m_dispatcher, ph::_1);
 
             m_scheduler = io::scheduler(std::unique_ptr<io::tcp_socket>(sock), callbacks);
+            m_scheduler.set_write_quota(storage::config().write_quota);
         } else {
             throw server::port_in_use{m_port};
         }
@@ -104,6 +112,29 @@ class server::server_impl {
     inline void set_config(const configuration &s) {
         storage::set_config(s);
         m_max_pending = s.max_connections;
+        m_scheduler.set_write_quota(s.write_quota);
+        if (s.precompress_on_startup && s.enable_compression) {
+            auto generated = cache::precompressed::generate(s.root_path);
+            debug("Precompressed " + std::to_string(generated) + " files");
+        }
+        if (s.watch_filesystem)
+            cache::watcher::start(s.root_path);
+        else
+            cache::watcher::stop();
+        if (!s.bundle_path.empty()) {
+            if (cache::bundle::open(s.bundle_path))
+                debug("Serving " + std::to_string(cache::bundle::size()) + " files from " + s.bundle_path);
+        } else {
+            cache::bundle::close();
+        }
+        if (!s.cache_snapshot.empty()) {
+            auto restored = cache::warmup::load_snapshot(s.cache_snapshot, s.warmup_threads);
+            debug("Restored " + std::to_string(restored) + " cached files");
+        }
+        if (!s.warmup_manifest.empty()) {
+            auto preloaded = cache::warmup::preload(s.warmup_manifest, s.warmup_threads);
+            debug("Preloaded " + std::to_string(preloaded) + " files");
+        }
     }
 };
 
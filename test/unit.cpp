@@ -0,0 +1,610 @@
+/*
+Copyright (C) 2015 Voinea Constantin Vladimir
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+/* Checks of the parts that need no server, one function per component. Built against the library in ../lib, see
+ * the unit target of the Makefile
+ */
+#include <cache/bundle.h>
+#include <cache/file_descriptor.h>
+#include <cache/path_cache.h>
+#include <cache/resource_cache.h>
+#include <http/content_negotiation.h>
+#include <http/content_sniffer.h>
+#include <http/header.h>
+#include <inl/mime_types.h>
+#include <misc/compression.h>
+#include <misc/storage.h>
+#include <misc/thread_pool.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <zlib.h>
+#ifdef VIKING_BROTLI
+#include <brotli/decode.h>
+#endif
+#ifdef VIKING_ZSTD
+#include <zstd.h>
+#endif
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK(condition)                                                                                              \
+    do {                                                                                                               \
+        if (!(condition)) {                                                                                            \
+            std::fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #condition);                                      \
+            ++failures;                                                                                                \
+        }                                                                                                              \
+    } while (false)
+
+static void path_cache_normalize() {
+    using cache::path_cache;
+    std::string normalized;
+    CHECK(path_cache::normalize("/", normalized) && normalized.empty());
+    CHECK(path_cache::normalize("/a/b.txt", normalized) && normalized == "/a/b.txt");
+    CHECK(path_cache::normalize("//a/./b//c/", normalized) && normalized == "/a/b/c");
+    CHECK(path_cache::normalize("/a/b/../c", normalized) && normalized == "/a/c");
+    CHECK(path_cache::normalize("/a/b.txt?x=/../..", normalized) && normalized == "/a/b.txt");
+    CHECK(path_cache::normalize("/a/..", normalized) && normalized.empty());
+    CHECK(!path_cache::normalize("/..", normalized));
+    CHECK(!path_cache::normalize("/a/../../etc/passwd", normalized));
+    /* Only whole segments are special */
+    CHECK(path_cache::normalize("/.../..a/a..", normalized) && normalized == "/.../..a/a..");
+}
+
+static std::vector<char> inflate(const std::vector<char> &compressed, int window_bits) {
+    z_stream stream{};
+    std::vector<char> out;
+    if (inflateInit2(&stream, window_bits) != Z_OK)
+        return out;
+    char piece[64 * 1024];
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(compressed.data()));
+    stream.avail_in = static_cast<uInt>(compressed.size());
+    int status = Z_OK;
+    while (status == Z_OK) {
+        stream.next_out = reinterpret_cast<Bytef *>(piece);
+        stream.avail_out = sizeof(piece);
+        status = ::inflate(&stream, Z_NO_FLUSH);
+        out.insert(out.end(), piece, piece + sizeof(piece) - stream.avail_out);
+    }
+    inflateEnd(&stream);
+    if (status != Z_STREAM_END)
+        out.clear();
+    return out;
+}
+
+static void compression_parallel() {
+    thread_pool pool{3};
+    std::vector<char> text;
+    for (std::size_t i = 0; text.size() < 1000 * 1000; ++i) {
+        auto line = "line " + std::to_string(i * 7919 % 10007) + " of a body that compresses well\n";
+        text.insert(text.end(), line.begin(), line.end());
+    }
+    /* Blocks that don't divide the body, a single block and blocks larger than the body */
+    for (std::size_t block_size : {std::size_t{64 * 1024}, std::size_t{100 * 1000 + 7}, text.size(), text.size() * 2}) {
+        using compression::format;
+        auto deflated = compression::parallel(pool, format::deflate, text.data(), text.size(), 6, block_size);
+        CHECK(inflate(deflated, MAX_WBITS) == text);
+        auto gzipped = compression::parallel(pool, format::gzip, text.data(), text.size(), 6, block_size);
+        CHECK(inflate(gzipped, MAX_WBITS + 16) == text);
+    }
+    std::vector<char> empty;
+    CHECK(inflate(compression::parallel(pool, compression::format::gzip, nullptr, 0, 6, 64 * 1024), MAX_WBITS + 16) ==
+          empty);
+}
+
+using coding = http::content_negotiation::coding;
+
+/* Only built in when the Makefile finds the decoders, with the same defines as the library */
+static void compression_encoders() {
+    std::vector<char> text;
+    for (std::size_t i = 0; text.size() < 300 * 1000; ++i) {
+        auto line = "{\"id\":" + std::to_string(i) + ",\"name\":\"item" + std::to_string(i * 7919 % 100003) + "\"},";
+        text.insert(text.end(), line.begin(), line.end());
+    }
+#ifdef VIKING_BROTLI
+    for (int quality : {1, 5, 11}) {
+        auto compressed = compression::brotli(text, quality);
+        std::vector<char> out(text.size());
+        std::size_t size = out.size();
+        CHECK(BrotliDecoderDecompress(compressed.size(), reinterpret_cast<const std::uint8_t *>(compressed.data()),
+                                      &size, reinterpret_cast<std::uint8_t *>(out.data())) ==
+              BROTLI_DECODER_RESULT_SUCCESS);
+        CHECK(size == text.size() && out == text);
+    }
+#endif
+#ifdef VIKING_ZSTD
+    /* The context is reused from one call to the next, the levels must not leak into each other */
+    for (int level : {1, 19, 3, 3}) {
+        auto compressed = compression::zstd(text, level);
+        std::vector<char> out(text.size());
+        CHECK(ZSTD_decompress(out.data(), out.size(), compressed.data(), compressed.size()) == text.size());
+        CHECK(out == text);
+    }
+    auto empty = compression::zstd(nullptr, 0, 3);
+    std::vector<char> none(1);
+    CHECK(ZSTD_decompress(none.data(), none.size(), empty.data(), empty.size()) == 0);
+#endif
+    CHECK(!text.empty());
+}
+
+static std::uint16_t quality(const http::content_negotiation::preferences &p, coding c) {
+    return p.quality[static_cast<std::size_t>(c)];
+}
+
+static void content_negotiation_parse() {
+    using http::content_negotiation;
+    auto none = content_negotiation::parse("");
+    CHECK(none.accepts(coding::identity));
+    CHECK(!none.accepts(coding::gzip));
+
+    auto plain = content_negotiation::parse("gzip, deflate");
+    CHECK(quality(plain, coding::gzip) == 1000);
+    CHECK(quality(plain, coding::deflate) == 1000);
+    CHECK(!plain.accepts(coding::br));
+
+    auto weighted = content_negotiation::parse("gzip;q=0.5, br ; q=0.25,DEFLATE;Q=1.000");
+    CHECK(quality(weighted, coding::gzip) == 500);
+    CHECK(quality(weighted, coding::br) == 250);
+    CHECK(quality(weighted, coding::deflate) == 1000);
+
+    auto refused = content_negotiation::parse("gzip;q=0, *;q=0.123");
+    CHECK(!refused.accepts(coding::gzip));
+    CHECK(quality(refused, coding::zstd) == 123);
+    CHECK(quality(refused, coding::identity) == 123);
+
+    auto nothing = content_negotiation::parse("*;q=0");
+    CHECK(!nothing.accepts(coding::identity));
+    CHECK(content_negotiation::parse("identity;q=0, gzip").accepts(coding::gzip));
+    CHECK(!content_negotiation::parse("identity;q=0, gzip").accepts(coding::identity));
+
+    /* Not a qvalue, taken as a refusal. More than three decimals are cut */
+    CHECK(!content_negotiation::parse("gzip;q=abc").accepts(coding::gzip));
+    CHECK(quality(content_negotiation::parse("gzip;q=0.9999"), coding::gzip) == 999);
+    CHECK(quality(content_negotiation::parse("x-gzip"), coding::gzip) == 1000);
+}
+
+static coding chosen(const std::string &accept_encoding) {
+    http::request request;
+    request.m_header.get_fields().set(http::header::fields::Accept_Encoding, accept_encoding);
+    return http::content_negotiation::choose(request, {coding::br, coding::gzip});
+}
+
+static void content_negotiation_choose() {
+    CHECK(chosen("") == coding::identity);
+    CHECK(chosen("gzip, br") == coding::br);
+    CHECK(chosen("br;q=0.5, gzip") == coding::gzip);
+    /* identity holds its own against the codings */
+    CHECK(chosen("identity;q=1, gzip;q=0.5") == coding::identity);
+    CHECK(chosen("identity;q=0.4, gzip;q=0.5") == coding::gzip);
+    CHECK(chosen("*;q=0.5") == coding::identity);
+    CHECK(chosen("identity;q=0, *;q=0.5") == coding::br);
+    CHECK(chosen("deflate") == coding::identity);
+}
+
+static std::string sniffed(const std::string &data) { return http::content_sniffer::sniff(data.data(), data.size()); }
+
+static void content_sniffer_sniff() {
+    using namespace std::string_literals;
+    /* The signature table, including the ones at an offset and the ones with zeros in them */
+    CHECK(sniffed("\x89PNG\r\n\x1a\n....") == "image/png");
+    CHECK(sniffed("\xff\xd8\xff\xe0") == "image/jpeg");
+    CHECK(sniffed("GIF89a") == "image/gif");
+    CHECK(sniffed("RIFF....WEBPVP8 ") == "image/webp");
+    CHECK(sniffed("RIFF....WAVEfmt ") == "audio/x-wav");
+    CHECK(sniffed("II*\0"s) == "image/tiff");
+    CHECK(sniffed("\0\0\1\0\1\0"s) == "image/x-icon");
+    CHECK(sniffed("%PDF-1.7") == "application/pdf");
+    CHECK(sniffed("PK\x03\x04") == "application/zip");
+    CHECK(sniffed("\x1f\x8b\x08") == "application/x-gzip");
+    CHECK(sniffed(std::string(257, '\0') + "ustar") == "application/x-tar");
+    CHECK(sniffed("\0\0\0\x18" "ftypmp42"s) == "video/mp4");
+    CHECK(sniffed("\0asm\1\0\0\0"s) == "application/wasm");
+    CHECK(sniffed("wOF2") == "font/woff2");
+    CHECK(sniffed("BM" + std::string(4, 'x') + std::string(8, '\0')) == "image/bmp");
+    /* Too short for the signature at its offset */
+    CHECK(sniffed("RIFF") == "text/plain");
+
+    /* Text: markup, JSON, scripts and plain text, with or without a byte order mark and leading space */
+    CHECK(sniffed("\xef\xbb\xbf  <!DOCTYPE html><html>") == "text/html");
+    CHECK(sniffed("<Html lang=en>") == "text/html");
+    CHECK(sniffed("<?xml version=\"1.0\"?><svg xmlns=\"\">") == "image/svg+xml");
+    CHECK(sniffed("<?xml version=\"1.0\"?><feed>") == "application/xml");
+    CHECK(sniffed("{\"a\": 1}") == "application/json");
+    CHECK(sniffed("[ 1, 2 ]") == "application/json");
+    CHECK(sniffed("[]") == "application/json");
+    CHECK(sniffed("[see below] for details") == "text/plain");
+    CHECK(sniffed("#!/bin/sh\necho") == "application/x-sh");
+    CHECK(sniffed("#!/usr/bin/env python3\n") == "text/plain");
+    CHECK(sniffed("just some words\n") == "text/plain");
+    /* UTF-8 is text, including right after an opening bracket */
+    CHECK(sniffed("[\xc3\xa9t\xc3\xa9]") == "application/json");
+    CHECK(sniffed("caf\xc3\xa9 cr\xc3\xa8me\n") == "text/plain");
+
+    CHECK(sniffed("") == "application/octet-stream");
+    CHECK(sniffed("   \n") == "application/octet-stream");
+    CHECK(sniffed("text\0with a zero"s) == "application/octet-stream");
+}
+
+static void header_map_lookup() {
+    using http::header_map;
+    typedef http::header::fields f;
+    header_map map;
+    map.set("content-TYPE", "text/html");
+    CHECK(map.size() == 1);
+    CHECK(map.get(f::Content_Type) && *map.get(f::Content_Type) == "text/html");
+    CHECK(map.get("Content-Type") && *map.get("Content-Type") == "text/html");
+    map.set(f::Content_Type, "text/plain");
+    CHECK(map.size() == 1 && *map.get("CONTENT-type") == "text/plain");
+    CHECK(!map.insert("Content-Type", "image/png") && *map.get(f::Content_Type) == "text/plain");
+    map.set("X-Custom", "a");
+    CHECK(map.get("x-custom") && *map.get("x-custom") == "a");
+    CHECK(!map.get(f::ETag) && !map.get("X-Missing"));
+
+    /* Past the inline slots, known and custom fields alike must still be found */
+    header_map spilled;
+    for (int i = 0; i < 12; ++i)
+        spilled.set("X-Field-" + std::to_string(i), std::to_string(i));
+    spilled.set(f::ETag, "\"tag\"");
+    spilled.set("x-field-3", "three");
+    CHECK(spilled.size() == 13);
+    CHECK(spilled.get("X-FIELD-11") && *spilled.get("X-FIELD-11") == "11");
+    CHECK(spilled.get("x-field-3") && *spilled.get("X-Field-3") == "three");
+    CHECK(spilled.get(f::ETag) && *spilled.get("etag") == "\"tag\"");
+    std::size_t visited = 0;
+    for (const auto &entry : spilled)
+        visited += entry.value.empty() ? 0 : 1;
+    CHECK(visited == 13);
+    spilled.clear();
+    CHECK(spilled.empty() && !spilled.get(f::ETag) && !spilled.get("X-Field-11"));
+}
+
+/* A scratch directory of files of the given size, named 0, 1, ... */
+static std::string scratch_files(int count, std::size_t size) {
+    char pattern[] = "/tmp/viking-unit-XXXXXX";
+    std::string directory = ::mkdtemp(pattern) ? pattern : "";
+    for (int i = 0; !directory.empty() && i < count; ++i)
+        std::ofstream(directory + '/' + std::to_string(i)) << std::string(size, 'a' + i % 26);
+    return directory;
+}
+
+static void resource_cache_s3fifo() {
+    using cache::resource_cache;
+    const auto directory = scratch_files(40, 1000);
+    CHECK(!directory.empty());
+    auto file = [&](int i) { return fs::path(directory + '/' + std::to_string(i)); };
+    auto cached = [](const fs::path &path) {
+        for (const auto &res : resource_cache::resources())
+            if (res.path() == path)
+                return true;
+        return false;
+    };
+    configuration settings;
+    settings.cache_byte_budget = 20 * 1000;
+    settings.cache_staleness_ms = 60 * 1000;
+    storage::set_config(settings);
+    resource_cache::invalidate({});
+
+    /* A file hit while on probation survives a scan over cold files twice the budget's size */
+    resource_cache::store(resource{file(0)});
+    CHECK(resource_cache::find(file(0)));
+    for (int i = 1; i <= 30; ++i)
+        resource_cache::store(resource{file(i)});
+    CHECK(cached(file(0)));
+    CHECK(!cached(file(1)) && cached(file(30)));
+    auto stats = resource_cache::stats();
+    CHECK(stats.entries == 20 && stats.bytes == 20 * 1000);
+    CHECK(stats.evictions == 11);
+
+    /* One evicted from probation is remembered and goes straight to the main queue when stored again, a new one
+     * starts on probation behind it
+     */
+    CHECK(!cached(file(11)) && !cached(file(10)));
+    resource_cache::store(resource{file(11)});
+    resource_cache::store(resource{file(31)});
+    auto resources = resource_cache::resources();
+    CHECK(!resources.empty() && resources.front().path() == file(11));
+    CHECK(resources.size() > 2 && resources[1].path() == file(0) && resources[2].path() == file(31));
+    CHECK(resource_cache::stats().bytes <= settings.cache_byte_budget);
+
+    resource_cache::invalidate({});
+    CHECK(resource_cache::stats().entries == 0 && resource_cache::stats().bytes == 0);
+    storage::set_config(configuration{});
+    fs::remove_all(directory);
+}
+
+static bool open_descriptor(int fd) { return fd != -1 && ::fcntl(fd, F_GETFD) != -1; }
+
+static void file_descriptor_lru() {
+    using cache::file_descriptor;
+    const auto directory = scratch_files(5, 100);
+    CHECK(!directory.empty());
+    auto file = [&](int i) { return directory + '/' + std::to_string(i); };
+    configuration settings;
+    settings.fd_cache_size = 2;
+    /* Without a watcher every aquire then checks the file on the disk */
+    settings.cache_staleness_ms = 0;
+    storage::set_config(settings);
+
+    /* Released descriptors are reused */
+    const int first = file_descriptor::aquire(file(0));
+    CHECK(open_descriptor(first) && file_descriptor::aquire(file(0)) == first);
+    CHECK(file_descriptor::size(first) == 100);
+    file_descriptor::release(first);
+    file_descriptor::release(first);
+    CHECK(file_descriptor::aquire(file(0)) == first);
+
+    /* A file unlinked while being sent is retired: its descriptor stays open until the last release */
+    ::unlink(file(0).c_str());
+    CHECK(file_descriptor::aquire(file(0)) == -1);
+    CHECK(open_descriptor(first) && !file_descriptor::stat(first));
+    file_descriptor::release(first);
+    CHECK(!open_descriptor(first));
+    std::ofstream(file(0)) << std::string(50, 'z');
+    const int recreated = file_descriptor::aquire(file(0));
+    CHECK(open_descriptor(recreated) && file_descriptor::size(recreated) == 50);
+    file_descriptor::release(recreated);
+
+    /* A file replaced while idle is opened again */
+    const auto inode = file_descriptor::stat(recreated)->inode;
+    std::ofstream(file(1)) << std::string(70, 'y');
+    fs::rename(file(1), file(0));
+    const int replaced = file_descriptor::aquire(file(0));
+    CHECK(file_descriptor::stat(replaced) && file_descriptor::stat(replaced)->inode != inode);
+    CHECK(file_descriptor::size(replaced) == 70);
+    file_descriptor::release(replaced);
+
+    /* Only fd_cache_size idle descriptors are kept, the least recently released is closed */
+    const int a = file_descriptor::aquire(file(2)), b = file_descriptor::aquire(file(3)),
+              c = file_descriptor::aquire(file(4));
+    file_descriptor::release(a);
+    file_descriptor::release(b);
+    file_descriptor::release(c);
+    CHECK(!file_descriptor::stat(a) && !file_descriptor::stat(replaced));
+    CHECK(file_descriptor::stat(b) && file_descriptor::stat(c) && open_descriptor(b) && open_descriptor(c));
+
+    file_descriptor::invalidate({});
+    CHECK(!open_descriptor(b) && !open_descriptor(c));
+    storage::set_config(configuration{});
+    fs::remove_all(directory);
+}
+
+template <typename T> static void append_bytes(std::string &out, T value) {
+    out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+/* The layout tools/bundle/pack.py writes, with identity bodies only. Index records are 88 bytes after the 32 byte
+ * header, then the string table, then the bodies
+ */
+static std::string packed_bundle(std::vector<std::pair<std::string, std::string>> files) {
+    auto fnv1a = [](const std::string &path) {
+        std::uint64_t result = 14695981039346656037ull;
+        for (unsigned char c : path)
+            result = (result ^ c) * 1099511628211ull;
+        return result;
+    };
+    std::sort(files.begin(), files.end(),
+              [&](const auto &a, const auto &b) { return fnv1a(a.first) < fnv1a(b.first); });
+    std::string strings, bodies;
+    const std::uint64_t strings_offset = 32 + 88 * files.size();
+    for (const auto &file : files)
+        strings += file.first + "text/plain" + "tag";
+    std::string out{"vkbundle"};
+    append_bytes<std::uint32_t>(out, 1);
+    append_bytes<std::uint32_t>(out, files.size());
+    append_bytes<std::uint64_t>(out, strings_offset);
+    append_bytes<std::uint64_t>(out, strings.size());
+    std::uint32_t string = 0;
+    for (const auto &file : files) {
+        append_bytes<std::uint64_t>(out, fnv1a(file.first));
+        const std::uint64_t body = strings_offset + strings.size() + bodies.size();
+        for (std::uint64_t offset : {body, std::uint64_t{0}, std::uint64_t{0}})
+            append_bytes(out, offset);
+        for (std::uint64_t length : {std::uint64_t{file.second.size()}, std::uint64_t{0}, std::uint64_t{0}})
+            append_bytes(out, length);
+        append_bytes<std::int64_t>(out, 1500000000);
+        for (std::uint32_t length : {std::uint32_t(file.first.size()), std::uint32_t{10}, std::uint32_t{3}}) {
+            append_bytes(out, string);
+            append_bytes(out, length);
+            string += length;
+        }
+        bodies += file.second;
+    }
+    return out + strings + bodies;
+}
+
+static void bundle_index() {
+    using cache::bundle;
+    char pattern[] = "/tmp/viking-unit-XXXXXX";
+    const std::string directory = ::mkdtemp(pattern) ? pattern : "";
+    CHECK(!directory.empty());
+    const auto path = directory + "/assets.bundle";
+    /* Renamed over the old one like a real deploy, which leaves the mapping in use intact */
+    auto deploy = [&](const std::string &contents) {
+        std::ofstream(path + ".new", std::ios::binary) << contents;
+        fs::rename(path + ".new", path);
+        return bundle::open(path);
+    };
+    auto served = [](const std::string &url) {
+        http::request request;
+        request.url = url;
+        auto entry = bundle::find(request);
+        return entry ? std::string(entry.data, entry.length) : std::string{"missing"};
+    };
+
+    const auto good = packed_bundle({{"/a.txt", "hello"}, {"/css/b.css", "body{}"}, {"/c", ""}});
+    CHECK(deploy(good) && bundle::size() == 3);
+    CHECK(served("/a.txt") == "hello" && served("/css/b.css") == "body{}" && served("/c").empty());
+    CHECK(served("/d") == "missing");
+
+    /* None of these may replace the bundle in use */
+    CHECK(!deploy({}));
+    CHECK(!deploy(good.substr(0, 20)));
+    CHECK(!deploy(good.substr(0, 32 + 88 + 40)));
+    CHECK(!deploy(good.substr(0, good.size() - 1)));
+    auto corrupt = good;
+    corrupt[0] = 'x';
+    CHECK(!deploy(corrupt));
+    corrupt = good;
+    corrupt[8] = 2;
+    CHECK(!deploy(corrupt));
+    /* Records out of hash order */
+    corrupt = good;
+    std::swap_ranges(corrupt.begin() + 32, corrupt.begin() + 32 + 88, corrupt.begin() + 32 + 88);
+    CHECK(!deploy(corrupt));
+    /* A path running past the string table */
+    corrupt = good;
+    corrupt[32 + 68] = 100;
+    CHECK(!deploy(corrupt));
+    /* A body starting past the end of the file */
+    corrupt = good;
+    corrupt[32 + 8 + 7] = 1;
+    CHECK(!deploy(corrupt));
+    CHECK(bundle::size() == 3 && served("/a.txt") == "hello");
+
+    bundle::close();
+    CHECK(bundle::size() == 0 && served("/a.txt") == "missing");
+    fs::remove_all(directory);
+}
+
+static void mime_types_find() {
+    /* Every extension of the list the table is generated from, the last type given for one wins like in process.py */
+    const auto source = std::string(__FILE__);
+    const auto slash = source.rfind('/');
+    std::ifstream list((slash == std::string::npos ? "." : source.substr(0, slash)) +
+                       "/../tools/mime_types/mime_types.txt");
+    CHECK(list);
+    std::map<std::string, std::string> expected;
+    for (std::string line; std::getline(list, line);) {
+        std::istringstream fields(line);
+        std::string type, extension;
+        fields >> type;
+        while (fields >> extension)
+            expected[extension] = type;
+    }
+    CHECK(expected.size() > 900);
+    std::size_t filled = 0;
+    for (const auto &slot : mime_types::slots)
+        filled += slot.type != nullptr;
+    CHECK(filled == expected.size());
+    for (const auto &pair : expected) {
+        auto upper = pair.first;
+        for (auto &c : upper)
+            c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        CHECK(mime_types::find(pair.first) && mime_types::find(pair.first) == pair.second);
+        CHECK(mime_types::find(upper) && mime_types::find(upper) == pair.second);
+        for (const auto &near : {pair.first + "x", pair.first.substr(1), pair.first.substr(0, pair.first.size() - 1)})
+            CHECK(expected.count(near) || !mime_types::find(near));
+    }
+    CHECK(mime_types::find("HtMl") && std::string(mime_types::find("HtMl")) == "text/html");
+    CHECK(!mime_types::find("") && !mime_types::find("no-such-type") && !mime_types::find(".html"));
+    static_assert(mime_types::find("css", 3) != nullptr, "lookups are constant expressions");
+}
+
+/* What a stream of its own, set up and torn down around the data, makes of it */
+static std::vector<char> fresh_deflate(int window_bits, int level, const std::vector<char> &data) {
+    z_stream stream{};
+    if (deflateInit2(&stream, level, Z_DEFLATED, window_bits, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+        return {};
+    std::vector<char> out(deflateBound(&stream, data.size()));
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data.data()));
+    stream.avail_in = static_cast<uInt>(data.size());
+    stream.next_out = reinterpret_cast<Bytef *>(out.data());
+    stream.avail_out = static_cast<uInt>(out.size());
+    const bool ended = ::deflate(&stream, Z_FINISH) == Z_STREAM_END;
+    out.resize(out.size() - stream.avail_out);
+    deflateEnd(&stream);
+    return ended ? out : std::vector<char>{};
+}
+
+static void compression_stream_reuse() {
+    using compression::format;
+    std::vector<char> text;
+    for (std::size_t i = 0; text.size() < 200 * 1000; ++i) {
+        auto line = "entry " + std::to_string(i * 31337 % 65521) + " in a log that repeats itself\n";
+        text.insert(text.end(), line.begin(), line.end());
+    }
+    const std::vector<char> other(text.rbegin(), text.rend());
+    const std::pair<format, int> formats[] = {{format::deflate, 15}, {format::gzip, 15 | 16}, {format::raw, -15}};
+    for (const auto &f : formats) {
+        for (int level : {1, 6, 9}) {
+            const auto expected = fresh_deflate(f.second, level, text);
+            CHECK(!expected.empty());
+
+            /* Contexts come back from the free list after a stream that ended, one that was abandoned half way and
+             * one that was primed, and must not carry any of that over
+             */
+            for (int round = 0; round < 4; ++round) {
+                {
+                    compression::stream previous{f.first, level};
+                    std::vector<char> ignored;
+                    if (round == 1)
+                        previous.write(other.data(), other.size() / 2, ignored);
+                    else if (round == 2 && f.first == format::raw)
+                        previous.prime(other.data(), 32 * 1024);
+                    else if (round == 3)
+                        previous.finish(other.data(), other.size(), ignored);
+                }
+                compression::stream reused{f.first, level};
+                std::vector<char> out;
+                reused.finish(text.data(), text.size(), out);
+                CHECK(out == expected);
+            }
+
+            /* The same output when written in pieces, and from a stream that was moved */
+            compression::stream pieces{f.first, level};
+            compression::stream moved{std::move(pieces)};
+            std::vector<char> out;
+            for (std::size_t at = 0; at < text.size(); at += 4096)
+                moved.write(text.data() + at, std::min<std::size_t>(4096, text.size() - at), out);
+            moved.finish(out);
+            CHECK(out == expected);
+        }
+    }
+    CHECK(compression::gzip(text) == fresh_deflate(15 | 16, Z_DEFAULT_COMPRESSION, text));
+    CHECK(compression::deflate(text) == fresh_deflate(15, Z_BEST_COMPRESSION, text));
+}
+
+int main() {
+    path_cache_normalize();
+    compression_parallel();
+    compression_encoders();
+    content_negotiation_parse();
+    content_negotiation_choose();
+    content_sniffer_sniff();
+    header_map_lookup();
+    resource_cache_s3fifo();
+    file_descriptor_lru();
+    bundle_index();
+    mime_types_find();
+    compression_stream_reuse();
+    if (failures)
+        std::fprintf(stderr, "%d failed\n", failures);
+    else
+        std::printf("All passed\n");
+    return failures != 0;
+}
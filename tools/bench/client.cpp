@@ -0,0 +1,71 @@
+/*
+Copyright (C) 2015 Voinea Constantin Vladimir
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+/* Requests one path over and over, a new connection each time, and reports requests and bytes per second.
+ *
+ *   make client && ./client <port> <path> <requests> [accept-encoding]
+ */
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+int main(int argc, char **argv) {
+    if (argc < 4) {
+        std::fprintf(stderr, "usage: %s <port> <path> <requests> [accept-encoding]\n", argv[0]);
+        return 1;
+    }
+    const auto port = static_cast<std::uint16_t>(std::atoi(argv[1]));
+    const std::string path = argv[2];
+    const int requests = std::atoi(argv[3]);
+    std::string request = "GET " + path + " HTTP/1.1\r\nHost: localhost\r\n";
+    if (argc > 4)
+        request += std::string("Accept-Encoding: ") + argv[4] + "\r\n";
+    request += "\r\n";
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+
+    std::vector<char> buffer(1 << 20);
+    std::size_t received = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < requests; ++i) {
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0 || connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0) {
+            std::perror("connect");
+            return 1;
+        }
+        send(fd, request.data(), request.size(), 0);
+        /* The server closes the connection after the response */
+        ssize_t bytes;
+        while ((bytes = recv(fd, buffer.data(), buffer.size(), 0)) > 0)
+            received += static_cast<std::size_t>(bytes);
+        close(fd);
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("%s: %d requests in %.3fs, %.0f req/s, %.1f MB/s\n", path.c_str(), requests, seconds,
+                requests / seconds, received / seconds / 1e6);
+}
@@ -0,0 +1,48 @@
+/*
+Copyright (C) 2015 Voinea Constantin Vladimir
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+/* Time spent turning a response into bytes, for a small and a large text body.
+ *
+ *   make serializer && LD_LIBRARY_PATH=../../lib ./serializer
+ */
+#include <http/response_serializer.h>
+#include <io/buffers/mem_buffer.h>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+
+int main() {
+    response_serializer serializer;
+    http::request request;
+    request.url = "/bench";
+    for (std::size_t size : {std::size_t{64}, std::size_t{1} << 20}) {
+        http::response response{request, std::string(size, 'a')};
+        const std::size_t iterations = size < 4096 ? 200000 : 2000;
+        /* Printed so that the loop can't be optimized away */
+        std::size_t sink = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            auto out = std::make_unique<io::memory_buffer>(serializer(response));
+            sink += out->data.size();
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+        std::cout << size << " bytes: " << ns / iterations << " ns/response (" << sink % 7 << ")\n";
+    }
+}
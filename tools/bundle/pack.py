@@ -0,0 +1,278 @@
+#!/usr/bin/env python3
+# Packs a directory tree into a bundle that the server maps and serves with
+# configuration::bundle_path set (see src/cache/bundle.cpp for the reader).
+#
+#   pack.py <directory> <bundle>
+#
+# The bundle is written next to its final name and renamed over it, so a
+# running server switches to the new set of files at once.
+#
+# Layout, little endian:
+#   header   magic "vkbundle", u32 version, u32 count, u64 strings, u64 strings size
+#   records  count records sorted by path hash: u64 hash, u64 offsets[3],
+#            u64 lengths[3], i64 last write, u32 path, path length, mime type,
+#            mime type length, etag, etag length
+#   strings  paths, mime types and etags
+#   bodies   the files and their br and gzip variants, large ones page aligned
+
+import argparse
+import gzip
+import hashlib
+import os
+import shutil
+import struct
+import sys
+import tempfile
+
+try:
+    import brotli
+except ImportError:
+    brotli = None
+
+MAGIC = b'vkbundle'
+VERSION = 1
+HEADER = struct.Struct('<8sIIQQ')
+RECORD = struct.Struct('<Q3Q3QqIIIIII')
+PAGE = 4096
+# Variants are only kept when they save at least this much
+MIN_SAVING = 0.1
+MIN_SIZE = 256
+SIBLINGS = ('.br', '.gz')
+# Files are read and compressed in pieces of this size, never as a whole
+CHUNK = 1024 * 1024
+
+# The rules of src/http/content_sniffer.cpp, so that a file without an extension gets the type the server would
+# give it on disk. Checked in order, longer signatures sharing a prefix first
+SNIFF_SIZE = 512
+SIGNATURES = (
+    (0, b'\x89PNG\r\n\x1a\n', 'image/png'),
+    (0, b'\xff\xd8\xff', 'image/jpeg'),
+    (0, b'GIF87a', 'image/gif'),
+    (0, b'GIF89a', 'image/gif'),
+    (8, b'WEBP', 'image/webp'),
+    (8, b'WAVE', 'audio/x-wav'),
+    (0, b'II*\0', 'image/tiff'),
+    (0, b'MM\0*', 'image/tiff'),
+    (0, b'\0\0\1\0', 'image/x-icon'),
+    (0, b'%PDF-', 'application/pdf'),
+    (0, b'%!PS', 'application/postscript'),
+    (0, b'PK\x03\x04', 'application/zip'),
+    (0, b'\x1f\x8b', 'application/x-gzip'),
+    (0, b'BZh', 'application/x-bzip2'),
+    (0, b'\xfd7zXZ\0', 'application/x-xz'),
+    (0, b'7z\xbc\xaf\x27\x1c', 'application/x-7z-compressed'),
+    (0, b'Rar!\x1a\x07', 'application/x-rar-compressed'),
+    (257, b'ustar', 'application/x-tar'),
+    (0, b'ID3', 'audio/mpeg'),
+    (0, b'OggS', 'audio/ogg'),
+    (0, b'fLaC', 'audio/x-flac'),
+    (4, b'ftyp', 'video/mp4'),
+    (0, b'\x1a\x45\xdf\xa3', 'video/webm'),
+    (0, b'\0asm', 'application/wasm'),
+    (0, b'wOFF', 'application/x-font-woff'),
+    (0, b'wOF2', 'font/woff2'),
+    (0, b'\x7fELF', 'application/octet-stream'),
+)
+HTML_TAGS = (b'<!doctype html', b'<html', b'<head', b'<body', b'<!--', b'<script', b'<title', b'<div', b'<p>')
+DEFAULT_TYPE = 'application/octet-stream'
+
+
+def read_mime_types():
+    table = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'mime_types', 'mime_types.txt')
+    result = dict()
+    with open(table) as file:
+        for line in file:
+            split = line.split()
+            for extension in split[1:]:
+                result[extension] = split[0]
+    return result
+
+
+def sniff_text(data):
+    if data.startswith(b'\xef\xbb\xbf'):
+        data = data[3:]
+    data = data.lstrip(b' \t\n\v\f\r')
+    if not data or any(c < 0x20 and c not in b'\t\n\r\f\x1b' for c in data):
+        return None
+    lowered = data.lower()
+    if lowered.startswith(HTML_TAGS):
+        return 'text/html'
+    xml = lowered.startswith(b'<?xml')
+    if lowered.startswith(b'<svg') or (xml and b'<svg' in data):
+        return 'image/svg+xml'
+    if xml:
+        return 'application/xml'
+    if data[:1] in (b'{', b'['):
+        # An object opens with a key or closes right away, an array holds anything but the rest of a sentence
+        rest = data[1:].lstrip(b' \t\n\v\f\r')
+        if not rest or rest[:1] in (b'"', b'}') or (data[:1] == b'[' and not rest[:1].isalpha()):
+            return 'application/json'
+    if len(data) > 2 and data.startswith(b'#!'):
+        return 'application/x-sh' if b'sh' in data[:64] else 'text/plain'
+    return 'text/plain'
+
+
+def sniff(data):
+    for offset, magic, mime_type in SIGNATURES:
+        if data[offset:offset + len(magic)] == magic:
+            return mime_type
+    # "BM" alone would take plenty of text files for bitmaps, the reserved header fields have to be zero too
+    if len(data) >= 14 and data.startswith(b'BM') and data[6:10] == b'\0\0\0\0':
+        return 'image/bmp'
+    return sniff_text(data) or DEFAULT_TYPE
+
+
+def mime_type(path, name, mime_types):
+    # Like io::get_extension, everything after the last dot, so .hidden has the extension hidden
+    dot = name.rfind('.')
+    extension = name[dot + 1:].lower() if dot != -1 else ''
+    if extension:
+        return mime_types.get(extension, DEFAULT_TYPE)
+    with open(path, 'rb') as file:
+        return sniff(file.read(SNIFF_SIZE))
+
+
+def fnv1a(data):
+    result = 14695981039346656037
+    for byte in data:
+        result ^= byte
+        result = (result * 1099511628211) & 0xffffffffffffffff
+    return result
+
+
+def worth_it(raw_size, size):
+    return size <= raw_size * (1 - MIN_SAVING)
+
+
+def chunks(file):
+    return iter(lambda: file.read(CHUNK), b'')
+
+
+def digest(path):
+    result = hashlib.sha1()
+    with open(path, 'rb') as file:
+        for chunk in chunks(file):
+            result.update(chunk)
+    return result.hexdigest()[:20]
+
+
+def compress(path, encoding):
+    # Into a temporary file, so that neither the file nor its variant is ever held in memory as a whole
+    if encoding == 'br' and brotli is None:
+        return None
+    body = tempfile.TemporaryFile()
+    with open(path, 'rb') as source:
+        if encoding == 'br':
+            compressor = brotli.Compressor()
+            for chunk in chunks(source):
+                body.write(compressor.process(chunk))
+            body.write(compressor.finish())
+        else:
+            with gzip.GzipFile(filename='', mode='wb', compresslevel=9, fileobj=body, mtime=0) as compressor:
+                shutil.copyfileobj(source, compressor, CHUNK)
+    return body
+
+
+def variant(f, suffix, encoding):
+    # A precompressed sibling when it is current, else the file compressed now. None when it doesn't pay off
+    candidate = f['source'] + suffix
+    if os.path.isfile(candidate) and os.path.getmtime(candidate) >= f['mtime']:
+        body = open(candidate, 'rb')
+    elif f['size'] >= MIN_SIZE:
+        body = compress(f['source'], encoding)
+    else:
+        body = None
+    if body is None:
+        return None
+    size = body.seek(0, os.SEEK_END)
+    if not worth_it(f['size'], size):
+        body.close()
+        return None
+    body.seek(0)
+    return body, size
+
+
+def bodies(f):
+    # Opened one at a time, in the order of the record's offsets: the file as it is, br, gzip
+    raw = open(f['source'], 'rb')
+    yield raw, os.fstat(raw.fileno()).st_size
+    yield variant(f, '.br', 'br')
+    yield variant(f, '.gz', 'gzip')
+
+
+def collect(root, mime_types):
+    files = []
+    for directory, _, names in os.walk(root):
+        for name in sorted(names):
+            path = os.path.join(directory, name)
+            if name.endswith(SIBLINGS) and os.path.isfile(path[:-3]):
+                continue
+            if not os.path.isfile(path):
+                continue
+            url = '/' + os.path.relpath(path, root).replace(os.sep, '/')
+            mtime = os.path.getmtime(path)
+            files.append({
+                'source': path,
+                'path': url.encode(),
+                'mime': mime_type(path, name, mime_types).encode(),
+                'etag': digest(path).encode(),
+                'size': os.path.getsize(path),
+                'mtime': mtime,
+            })
+    files.sort(key=lambda f: (fnv1a(f['path']), f['path']))
+    return files
+
+
+def align(offset, boundary=PAGE):
+    return (offset + boundary - 1) // boundary * boundary
+
+
+def pack(root, target):
+    files = collect(root, read_mime_types())
+
+    strings = bytearray()
+    def intern(data):
+        offset = len(strings)
+        strings.extend(data)
+        return offset, len(data)
+
+    names = [(intern(f['path']), intern(f['mime']), intern(f['etag'])) for f in files]
+    strings_offset = HEADER.size + RECORD.size * len(files)
+    offset = align(strings_offset + len(strings))
+
+    # The bodies go in first, the index in front of them once their offsets are known
+    temporary = target + '.tmp'
+    with open(temporary, 'wb') as out:
+        records = []
+        for f, (path, mime, etag) in zip(files, names):
+            offsets, lengths = [0, 0, 0], [0, 0, 0]
+            for i, body in enumerate(bodies(f)):
+                if body is None:
+                    continue
+                file, length = body
+                with file:
+                    if length >= PAGE:
+                        offset = align(offset)
+                    out.seek(offset)
+                    shutil.copyfileobj(file, out, CHUNK)
+                offsets[i], lengths[i] = offset, length
+                offset = align(offset + length, 8)
+            records.append(RECORD.pack(fnv1a(f['path']), *offsets, *lengths, int(f['mtime']), *path, *mime, *etag))
+        out.seek(0)
+        out.write(HEADER.pack(MAGIC, VERSION, len(files), strings_offset, len(strings)))
+        for record in records:
+            out.write(record)
+        out.write(strings)
+        out.truncate(offset)
+    os.rename(temporary, target)
+    return len(files)
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='Packs a directory into a bundle served by viking')
+    parser.add_argument('directory')
+    parser.add_argument('bundle')
+    arguments = parser.parse_args()
+    if not os.path.isdir(arguments.directory):
+        sys.exit(arguments.directory + ' is not a directory')
+    print('Packed %d files' % pack(arguments.directory, arguments.bundle))
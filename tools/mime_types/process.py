@@ -20,21 +20,113 @@ def make_dictionary(lines):
             result[extension] = mime_type
     return result
 
-def write_unordered_map(dict, file_name):
+LICENSE = """/*
+Copyright (C) 2015 Voinea Constantin Vladimir
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+"""
+
+# FNV-1a over the lowercased extension, mixed with a seed. Must match mime_types::hash in the generated header
+def fnv1a(key, seed):
+    h = (2166136261 ^ seed) & 0xffffffff
+    for c in key.lower().encode():
+        h ^= c
+        h = (h * 16777619) & 0xffffffff
+    return h
+
+# Hash and displace: every key is put in one of a few buckets with seed 0, then each bucket, biggest first,
+# gets the smallest seed that sends all of its keys to free slots. A lookup is two hashes and one compare.
+def make_perfect_hash(keys):
+    bucket_count = max(1, len(keys) // 4)
+    slot_count = len(keys) + len(keys) // 4 + 1
+    buckets = [[] for _ in range(bucket_count)]
+    for key in keys:
+        buckets[fnv1a(key, 0) % bucket_count].append(key)
+    seeds = [0] * bucket_count
+    slots = [None] * slot_count
+    for index in sorted(range(bucket_count), key=lambda i: -len(buckets[i])):
+        bucket = buckets[index]
+        if not bucket:
+            continue
+        seed = 1
+        while True:
+            positions = [fnv1a(key, seed) % slot_count for key in bucket]
+            if len(set(positions)) == len(positions) and all(slots[p] is None for p in positions):
+                break
+            seed += 1
+        seeds[index] = seed
+        for key, position in zip(bucket, positions):
+            slots[position] = key
+    return seeds, slots
+
+def write_perfect_hash(dict, file_name):
+    seeds, slots = make_perfect_hash(sorted(dict))
     file = open(file_name, 'w')
-    file.write("#include <unordered_map>\n#include <string>\n\n")
-    file.write("static std::unordered_map<std::string, std::string> mime_types {\n")
-    i = 0
-    for key in dict:
-        i = i+1
-        file.write("{\"" + key + "\"" + ", \"" + dict[key] + "\"}")
-        if i < len(dict):
-            file.write(",")
-        file.write("\n")
-    file.write("};\n")
+    file.write(LICENSE)
+    file.write("#ifndef MIME_TYPES_H\n#define MIME_TYPES_H\n\n")
+    file.write("#include <cstddef>\n#include <cstdint>\n#include <string>\n\n")
+    file.write("/* Generated by tools/mime_types/process.py from mime_types.txt, do not edit.\n")
+    file.write(" * A perfect hash over the extensions: lookups are case insensitive, allocate nothing, and the tables\n")
+    file.write(" * are constants, so nothing runs at startup.\n */\n")
+    file.write("namespace mime_types {\n")
+    file.write("struct entry {\n    const char *extension;\n    std::size_t extension_size;\n    const char *type;\n};\n\n")
+    file.write("constexpr std::size_t bucket_count = %d;\n" % len(seeds))
+    file.write("constexpr std::size_t slot_count = %d;\n\n" % len(slots))
+    file.write("constexpr std::uint16_t seeds[bucket_count] = {\n")
+    for i in range(0, len(seeds), 16):
+        file.write("    " + ", ".join(str(seed) for seed in seeds[i:i + 16]) + ",\n")
+    file.write("};\n\n")
+    file.write("constexpr entry slots[slot_count] = {\n")
+    for key in slots:
+        if key is None:
+            file.write("    {\"\", 0, nullptr},\n")
+        else:
+            file.write("    {\"%s\", %d, \"%s\"},\n" % (key.lower(), len(key), dict[key]))
+    file.write("};\n\n")
+    file.write("""constexpr char lower(char c) noexcept { return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c; }
+
+constexpr std::uint32_t hash(const char *data, std::size_t size, std::uint32_t seed) noexcept {
+    std::uint32_t h = 2166136261u ^ seed;
+    for (std::size_t i = 0; i < size; ++i) {
+        h ^= static_cast<unsigned char>(lower(data[i]));
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/* The type registered for the extension (without the dot), null when there is none */
+constexpr const char *find(const char *extension, std::size_t size) noexcept {
+    const auto &candidate = slots[hash(extension, size, seeds[hash(extension, size, 0) % bucket_count]) % slot_count];
+    if (candidate.extension_size != size || !candidate.type)
+        return nullptr;
+    for (std::size_t i = 0; i < size; ++i)
+        if (lower(extension[i]) != candidate.extension[i])
+            return nullptr;
+    return candidate.type;
+}
+
+inline const char *find(const std::string &extension) noexcept { return find(extension.data(), extension.size()); }
+}
+
+#endif // MIME_TYPES_H
+""")
     file.close()
 
 raw_lines = read_file("mime_types.txt")
 dictionary = make_dictionary(raw_lines)
 write_dictionary(dictionary, "mime_types_map.txt")
-write_unordered_map(dictionary, "mime_types.h")
+write_perfect_hash(dictionary, "mime_types.h")